@@ -0,0 +1,149 @@
+#ifndef __AUTOAIM__
+#define __AUTOAIM__
+
+#include "global.hpp"
+#include "tracker.hpp"
+#include "util.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+
+namespace aim
+{
+    // which goal to track, autoAim() and the driver controls set it
+    std::atomic<int> signature(blueSig);
+
+    /* while set every frame is appended to /usd/visionN.csv for tools/aimreplay.cpp. each power on gets the next
+    unused N, since the timestamps start over and the replay needs them to only go forward
+    */
+    std::atomic<bool> recording(false);
+    char recordPath[24] = "";
+
+    util::snapshot<target> goal;
+
+    // the first time this power on, picks a new file and writes its header
+    FILE* openRecording()
+    {
+        if (recordPath[0] != '\0')
+        {
+            return fopen(recordPath, "a");
+        }
+
+        for (int i = 0; i < 1000; i++)
+        {
+            char path[sizeof(recordPath)];
+            snprintf(path, sizeof(path), "/usd/vision%d.csv", i);
+            FILE* existing = fopen(path, "r");
+
+            if (existing != NULL)
+            {
+                fclose(existing);
+                continue;
+            }
+
+            FILE* file = fopen(path, "w");
+
+            if (file != NULL)
+            {
+                strcpy(recordPath, path);
+                fprintf(file, "time,heading,signature,left,top,width,height\n");
+            }
+
+            return file;
+        }
+
+        return NULL;
+    }
+
+    void record(FILE* & file, const pros::vision_object_s_t* objects, int count, int time)
+    {
+        if (file == NULL)
+        {
+            file = openRecording();
+
+            if (file == NULL)
+            {
+                recording = false;
+                return;
+            }
+        }
+
+        double heading = robot::imu.degHeading();
+
+        // empty frames still get a row so the replay sees the dropouts
+        if (count <= 0 || count > maxObjects)
+        {
+            fprintf(file, "%d,%f,0,0,0,0,0\n", time, heading);
+            return;
+        }
+
+        for (int i = 0; i < count; i++)
+        {
+            fprintf(file, "%d,%f,%d,%d,%d,%d,%d\n", time, heading, objects[i].signature, objects[i].left_coord, objects[i].top_coord, objects[i].width, objects[i].height);
+        }
+    }
+
+    /* reads every blob once per frame and runs it through the tracker, the result is published to goal for anything
+    that needs to aim
+    */
+    void track()
+    {
+        pros::vision_object_s_t objects[maxObjects];
+        aim::tracker filter;
+        FILE* file = NULL;
+
+        while (true)
+        {
+            uint64_t start = pros::micros();
+            int count = glb::vision.read_by_size(0, maxObjects, objects);
+            int latency = pros::micros() - start;
+
+            // a failed read leaves the buffer as it was, so it counts as a frame with nothing in it
+            if (count == PROS_ERR)
+            {
+                count = 0;
+            }
+
+            int time = pros::millis();
+
+            target state = filter.update(objects, count, signature);
+            state.latency = latency;
+            state.time = time;
+            goal.write(state);
+
+            if (recording)
+            {
+                record(file, objects, count, time);
+            }
+
+            else if (file != NULL)
+            {
+                fclose(file);
+                file = NULL;
+            }
+
+            pros::delay(period);
+        }
+    }
+}
+
+// turns in place onto the goal with the given signature
+void autoAim(double timeout, int sig)
+{
+    util::timer timer;
+    util::pid pid(aim::constants, 1000);
+    aim::signature = sig;
+
+    while (timer.time() < timeout)
+    {
+        aim::target goal = aim::goal.read();
+        double vel = goal.visible ? pid.out(goal.error) : 0;
+
+        robot::chass.spinDiffy(-vel, vel);
+        pros::delay(10);
+    }
+
+    robot::chass.stop("b");
+}
+
+#endif
@@ -1,6 +1,7 @@
 #include "chassis.hpp"
 #include "global.hpp"
 #include "intake.hpp"
+#include "script.hpp"
 #include "flywheel.hpp"
 #include "pros/rtos.hpp"
 #include "util.hpp"
@@ -135,7 +136,6 @@ void skillsNew()
     pros::delay(350);
     chas::drive(-950, 650, 3);
     autoAim(500, 1);
-    flywheel::ff = 3;
 
     robot::intake.spin(-70);
     pros::delay(600);
@@ -146,14 +146,12 @@ void skillsNew()
     pros::delay(300);
     robot::chass.stop("b");
     autoAim(800, 1);
-    flywheel::ff = 3;
     robot::intake.spin(-50);
     pros::delay(720);
     robot::intake.spin(127);
     chas::spinTo(91,800);
     chas::drive(2000,1000,1);
     autoAim(800, 1);
-    flywheel::ff = 3;
     robot::intake.spin(-50);
     pros::delay(720);
 
@@ -191,7 +189,6 @@ void skillsNew()
     robot::tsukasa.toggle(); 
     chas::drive(-2700,1500,3);
     autoAim(700,2);
-    flywheel::ff = 3;
     robot::intake.spin(-80);
     pros::delay(1000);
     robot::intake.stop("c");
@@ -209,7 +206,6 @@ void skillsNew()
     autoAim(400,2);
     robot::intake.stop("c");
     robot::tsukasa.toggle();
-    flywheel::ff = 3;
     robot::intake.spin(-80);
     pros::delay(900);
     robot::intake.stop("c");
@@ -260,7 +256,6 @@ void skillsNew()
     autoAim(400,2);
 
 
-    flywheel::ff = 3;
     robot::intake.spin(-60);
     pros::delay(700);
 
@@ -271,10 +266,8 @@ void skillsNew()
         pros::delay(350);
         robot::intake.stop("c");
         pros::delay(100);
-        flywheel::ff = 3;
         robot::intake.spin(-50);
         pros::delay(250);
-        flywheel::ff = -1;
         robot::intake.stop("c");
     }
 
@@ -324,10 +317,8 @@ void skills()
         pros::delay(350);
         robot::intake.stop("c");
         pros::delay(100);
-        flywheel::ff = 3;
         robot::intake.spin(-50);
         pros::delay(250);
-        flywheel::ff = -1;
         robot::intake.stop("c");
     }
 
@@ -348,7 +339,6 @@ void skills()
     pros::delay(350);
     chas::drive(-950, 650, 3);
     chas::spinTo(355, 800);
-    flywheel::ff = 3;
 
     robot::intake.spin(-70);
     pros::delay(600);
@@ -397,7 +387,6 @@ void skills()
     robot::tsukasa.toggle(); 
     // chas::autoDrive(-2700,272,1500);
     chas::spinTo(290, 800);
-    flywheel::ff = 3;
     robot::intake.spin(-80);
     pros::delay(1000);
     // intake::waitIndex(3,20);
@@ -418,7 +407,6 @@ void skills()
     chas::spinTo(237, 800);
     robot::intake.stop("c");
     robot::tsukasa.toggle();
-    flywheel::ff = 3;
     robot::intake.spin(-80);
     pros::delay(900);
     // intake::waitIndex(3,15);
@@ -511,7 +499,6 @@ void skills()
 
 
     // chas::spinTo(172, 1000, smallTurn);
-    flywheel::ff = 3;
     robot::intake.spin(-60);
     pros::delay(700);
 
@@ -522,10 +509,8 @@ void skills()
         pros::delay(350);
         robot::intake.stop("c");
         pros::delay(100);
-        flywheel::ff = 3;
         robot::intake.spin(-50);
         pros::delay(250);
-        flywheel::ff = -1;
         robot::intake.stop("c");
     }
 
@@ -731,10 +716,8 @@ void skillsReach()
         pros::delay(350);
         robot::intake.stop("c");
         pros::delay(100);
-        flywheel::ff = 3;
         robot::intake.spin(-50);
         pros::delay(250);
-        flywheel::ff = -1;
         robot::intake.stop("c");
     }
 
@@ -756,7 +739,6 @@ void skillsReach()
     chas::drive(-950, 650, 3);
     autoAim(400,2);
     // chas::spinTo(355, 800);
-    flywheel::ff = 3;
 
     robot::intake.spin(-70);
     pros::delay(600);
@@ -805,7 +787,6 @@ void skillsReach()
     robot::tsukasa.toggle(); 
     // chas::autoDrive(-2700,272,1500);
     autoAim(800,2);
-    flywheel::ff = 3;
     robot::intake.spin(-80);
     pros::delay(1000);
     // intake::waitIndex(3,20);
@@ -826,7 +807,6 @@ void skillsReach()
     autoAim(800,2);
     robot::intake.stop("c");
     robot::tsukasa.toggle();
-    flywheel::ff = 3;
     robot::intake.spin(-80);
     pros::delay(900);
     // intake::waitIndex(3,15);
@@ -887,7 +867,6 @@ void skillsReach()
 
     // chas::spinTo(172, 1000, smallTurn);
     autoAim(300,2);
-    flywheel::ff = 3;
     robot::intake.spin(-60);
     pros::delay(700);
 
@@ -898,10 +877,8 @@ void skillsReach()
         pros::delay(350);
         robot::intake.stop("c");
         pros::delay(100);
-        flywheel::ff = 3;
         robot::intake.spin(-50);
         pros::delay(250);
-        flywheel::ff = -1;
         robot::intake.stop("c");
     }
 
@@ -995,7 +972,7 @@ void driverAut()
 
 
 // std::vector<void (*)()> autons{wp,a};
-fptr WP = wp; fptr SKILLSNEW = skillsNew; fptr SKILLS = skills; fptr NEARHALF = nearHalf; fptr FARHALF = farHalf; fptr FIVENEARHALF = fiveNearHalf; fptr DRIVER = driverAut; fptr SKILLSREACH = skillsReach; fptr NEARSAFE = nearSafe;
+fptr WP = wp; fptr SKILLSNEW = skillsNew; fptr SKILLS = skills; fptr NEARHALF = nearHalf; fptr FARHALF = farHalf; fptr FIVENEARHALF = fiveNearHalf; fptr DRIVER = driverAut; fptr SKILLSREACH = skillsReach; fptr NEARSAFE = nearSafe; fptr FWCHAR = flywheel::characterize; fptr SDAUTON = script::fromCard; fptr RANGECAL = shot::calibrateRange;
 
-std::vector<fptr> autons{WP, SKILLSNEW, SKILLS, NEARHALF, FARHALF, FIVENEARHALF, DRIVER, SKILLSREACH, NEARSAFE};
-std::vector<std::string> autonNames{"wp","skillsNew", "skills","nearHalf", "farHalf", "fiveNearHalf", "driverAut", "skillsReach", "nearSafe" };
+std::vector<fptr> autons{WP, SKILLSNEW, SKILLS, NEARHALF, FARHALF, FIVENEARHALF, DRIVER, SKILLSREACH, NEARSAFE, FWCHAR, SDAUTON, RANGECAL};
+std::vector<std::string> autonNames{"wp","skillsNew", "skills","nearHalf", "farHalf", "fiveNearHalf", "driverAut", "skillsReach", "nearSafe", "fwChar", "sdAuton", "rangeCal" };
@@ -0,0 +1,107 @@
+#ifndef __BATTERY__
+#define __BATTERY__
+
+#include "main.h"
+#include "pros/misc.hpp"
+#include "pros/rtos.hpp"
+#include "telemetry.hpp"
+#include "util.hpp"
+#include <cstdint>
+
+/* keeps an eye on the pack voltage and scales voltage commands by it. group::mtrs::spin(), the chassis and the drive
+velocity loop all go through compensate(), so 100 at the end of skills pushes the same as 100 on a fresh battery.
+the flywheel feedforward and the intake go through mtrs::spin() so they get it too
+
+a sag is the pack dropping sagDrop under its slow average, usually a stall or everything starting at once. each one is
+logged when it ends with how low it went, how long it lasted and the peak current
+*/
+namespace battery
+{
+    const double nominal = 12000;       // mV the gains are tuned at
+    const double minScale = 0.85;       // a charger fresh pack
+    const double maxScale = 1.4;        // past this the motors can't get more anyway
+    const int period = 20;
+
+    // sag detection, mV under the slow average
+    const double sagDrop = 700;
+
+    const uint16_t batteryLog = telemetry::define("battery", "voltage,current,scale");
+    const uint16_t sagLog = telemetry::define("battery.sag", "min,duration,current");
+
+    // filtered pack voltage in mV, nominal until the first sample
+    util::atomicDouble voltage(nominal);
+
+    // what a command is multiplied by
+    double scale()
+    {
+        double s = nominal / voltage;
+        return(s < minScale ? minScale : s > maxScale ? maxScale : s);
+    }
+
+    // move() volts in, move() volts out, still clamped to -127 to 127
+    double compensate(double volts)
+    {
+        double out = volts * scale();
+        return(out > 127 ? 127 : out < -127 ? -127 : out);
+    }
+
+    void monitor()
+    {
+        double fast = pros::battery::get_voltage();
+        double slow = fast;
+        bool sagging = false;
+        uint32_t sagStart = 0;
+        double sagMin = 0;
+        double sagCurrent = 0;
+        uint32_t lastLog = 0;
+        uint32_t wake = pros::millis();
+
+        while (true)
+        {
+            double raw = pros::battery::get_voltage();
+            double current = pros::battery::get_current();
+
+            // ~100ms for the commands, ~5s for what the pack sits at
+            fast += (raw - fast) * 0.2;
+            slow += (raw - slow) * 0.004;
+            voltage = fast;
+
+            if (!sagging && raw < slow - sagDrop)
+            {
+                sagging = true;
+                sagStart = pros::millis();
+                sagMin = raw;
+                sagCurrent = current;
+            }
+
+            else if (sagging)
+            {
+                sagMin = raw < sagMin ? raw : sagMin;
+                sagCurrent = current > sagCurrent ? current : sagCurrent;
+
+                if (raw > slow - sagDrop / 2)
+                {
+                    sagging = false;
+                    telemetry::record(sagLog, sagMin, pros::millis() - sagStart, sagCurrent);
+                }
+            }
+
+            if (pros::millis() - lastLog >= 1000)
+            {
+                lastLog = pros::millis();
+                telemetry::record(batteryLog, fast, current, scale());
+            }
+
+            pros::Task::delay_until(&wake, period);
+        }
+    }
+
+    // before the control tasks so they start with a real voltage
+    void start()
+    {
+        voltage = pros::battery::get_voltage();
+        pros::Task sampler(monitor, TASK_PRIORITY_DEFAULT + 1, TASK_STACK_DEPTH_DEFAULT, "battery");
+    }
+}
+
+#endif
@@ -0,0 +1,170 @@
+#ifndef __BUDGET__
+#define __BUDGET__
+
+#include "main.h"
+#include "flywheel.hpp"
+#include "global.hpp"
+#include "intake.hpp"
+#include "pros/rtos.hpp"
+#include "shot.hpp"
+#include "telemetry.hpp"
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+/* splits the motor current between the drive, intake and flywheel by what the robot is doing, and backs a motor off
+before the firmware does it for us. the v5 motors halve their current at 55C and keep cutting above that without
+saying anything, so a hot drive motor halfway through skills just goes soft
+
+each motor gets an estimated temperature from its current out of the sensors frame, heating with current squared and
+cooling toward ambient. the reported temperature only moves in 5C steps so the estimate is kept inside the step it
+reports. if the estimate says a motor throttles within horizon seconds its limit is scaled down so it gets there
+slower, except the flywheel while it's shooting or recovering from a shot, which always gets its full share
+*/
+namespace budget
+{
+    enum mode
+    {
+        driving,
+        intaking,
+        shooting
+    };
+
+    // mA per motor, per mode
+    struct split
+    {
+        int chassis;
+        int intake;
+        int flywheel;
+    };
+
+    const split splits[3] = {
+        {2500, 1500, 2500},     // driving
+        {2200, 2500, 1800},     // intaking, the flywheel only has to hold speed
+        {2000, 1000, 2500},     // shooting, the intake only pushes a disc
+    };
+
+    // - thermal model, celsius and amps
+    const double ambient = 25;
+    const double throttle = 55;
+    const double heating = 0.15;        // C/s per A^2
+    const double cooling = 1.0 / 300;   // per second, toward ambient
+    const double horizon = 30;          // seconds
+    const double minScale = 0.4;        // lowest a hot motor gets scaled to
+    const int period = 100;
+
+    // the autons can force a mode, -1 leaves it to what the robot is doing
+    std::atomic<int> force(-1);
+
+    const uint16_t budgetLog = telemetry::define("budget", "mode,hottest,seconds");
+
+    struct motor
+    {
+        group::mtrs * owner;
+        int index;
+        int split::*share;
+        double estimate;
+        int limit;
+    };
+
+    std::vector<motor> motors;
+
+    // seconds until the estimate reaches throttle at the current draw, -1 if it never does
+    double timeToThrottle(double temperature, double amps)
+    {
+        double rate = heating * amps * amps - cooling * (temperature - ambient);
+
+        if (temperature >= throttle)
+        {
+            return 0;
+        }
+
+        return(rate <= 0 ? -1 : (throttle - temperature) / rate);
+    }
+
+    mode current()
+    {
+        if (force >= 0)
+        {
+            return (mode)force.load();
+        }
+
+        // intake voltage out of the frame, negative is pushing discs into the flywheel
+        double intakeVolts = robot::intake.getVoltage(0);
+
+        if (shot::volley > 0 || intake::status.read().indexing || intakeVolts < -1000)
+        {
+            return shooting;
+        }
+
+        return(intakeVolts > 1000 ? intaking : driving);
+    }
+
+    void add(group::mtrs & motorGroup, int split::*share)
+    {
+        for (int i = 0; i < motorGroup.count(); i++)
+        {
+            motors.push_back(motor{&motorGroup, i, share, ambient, 2500});
+        }
+    }
+
+    void manage()
+    {
+        add(robot::chass, &split::chassis);
+        add(robot::intake, &split::intake);
+        add(robot::flywheel, &split::flywheel);
+
+        uint32_t wake = pros::millis();
+
+        while (true)
+        {
+            mode m = current();
+            bool flywheelFull = m == shooting || flywheel::status.read().recovering;
+            double hottest = 0;
+            double soonest = -1;
+
+            for (motor & mtr : motors)
+            {
+                double amps = mtr.owner->getCurrent(mtr.index) / 1000;
+                double reported = mtr.owner->getTemperature(mtr.index);
+
+                mtr.estimate += (heating * amps * amps - cooling * (mtr.estimate - ambient)) * period / 1000;
+
+                // 0 is a motor that hasn't reported yet
+                if (reported > 0)
+                {
+                    mtr.estimate = mtr.estimate < reported ? reported : mtr.estimate > reported + 5 ? reported + 5 : mtr.estimate;
+                }
+
+                double seconds = timeToThrottle(mtr.estimate, amps);
+                double scale = seconds < 0 || seconds > horizon ? 1 : minScale + (1 - minScale) * seconds / horizon;
+                int limit = splits[m].*mtr.share;
+
+                if (!(flywheelFull && mtr.share == &split::flywheel))
+                {
+                    limit *= scale;
+                }
+
+                // only talk to the motor when the limit moves
+                if (limit != mtr.limit)
+                {
+                    mtr.limit = limit;
+                    mtr.owner->setCurrentLimit(mtr.index, limit);
+                }
+
+                hottest = mtr.estimate > hottest ? mtr.estimate : hottest;
+                soonest = seconds >= 0 && (soonest < 0 || seconds < soonest) ? seconds : soonest;
+            }
+
+            telemetry::record(budgetLog, m, hottest, soonest);
+            pros::Task::delay_until(&wake, period);
+        }
+    }
+
+    void start()
+    {
+        pros::Task manager(manage, TASK_PRIORITY_DEFAULT, TASK_STACK_DEPTH_DEFAULT, "budget");
+    }
+}
+
+#endif
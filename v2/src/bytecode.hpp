@@ -0,0 +1,198 @@
+#ifndef __BYTECODE__
+#define __BYTECODE__
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+/* the compiled auton format and the checks run on it when it's loaded, kept apart from the devices so
+tools/autoncheck.cpp can run the same checks on a computer. script.hpp runs the code
+
+file layout: "AUT1", uint32 code length, code. each step is a one byte opcode and a fixed number of little endian
+floats, a parallel is the opcode, a branch count, then each branch as a uint32 length and its code. the whole file is
+checked when it's loaded, so exec() never has to
+*/
+namespace script
+{
+    enum class op : uint8_t
+    {
+        wait = 1,
+        spinTo,
+        drive,
+        autoDrive,
+        odomDrive,
+        moveTo,
+        timedSpin,
+        velsUntilHeading,
+        arcTurn,
+        chassis,
+        chassisStop,
+        intake,
+        intakeStop,
+        index,
+        waitIndex,
+        toggle,
+        flywheel,
+        waitReady,
+        piston,
+        volley,
+        waitVolley,
+        aim,
+        parallel,
+        goal,
+    };
+
+    // floats after each opcode, has to match OPS in tools/autonc.py. a parallel's branches follow it instead
+    const uint8_t argc[] = {0, 1, 8, 3, 15, 3, 18, 3, 5, 9, 2, 1, 1, 1, 1, 6, 2, 1, 3, 2, 1, 1, 2, 0, 2};
+    const int maxArgs = 18;
+
+    // whole numbers from lo to hi
+    bool inRange(float value, int lo, int hi)
+    {
+        return(value >= lo && value <= hi && value == (int)value);
+    }
+
+    // values exec() indexes with or can't take, tools/autonc.py rejects the same ones
+    bool validArgs(op o, const float * a)
+    {
+        for (int i = 0; i < argc[(int)o]; i++)
+        {
+            if (!std::isfinite(a[i]))
+            {
+                return(false);
+            }
+        }
+
+        switch (o)
+        {
+            case op::chassisStop:
+            case op::intakeStop: return(inRange(a[0], 0, 2));
+            case op::piston: return(inRange(a[0], 0, 3) && inRange(a[1], 0, 2));
+            case op::index:
+            case op::waitIndex:
+            case op::volley: return(inRange(a[0], 0, 255));
+            case op::wait: return(a[0] >= 0);
+            default: return(true);
+        }
+    }
+
+    /* true if [pc, end) is nothing but whole steps with valid arguments. flywheel::waitReady wakes one task, and
+    intake::waitIndex waits on it, so only one branch of a parallel may use either. waits is set if the range does
+    */
+    bool check(const uint8_t * pc, const uint8_t * end, bool * waits = nullptr)
+    {
+        bool waited = false;
+
+        while (pc < end)
+        {
+            uint8_t o = *pc++;
+
+            if (o == (uint8_t)op::parallel)
+            {
+                if (pc >= end)
+                {
+                    return(false);
+                }
+
+                int branches = *pc++;
+                int waiting = 0;
+
+                for (int i = 0; i < branches; i++)
+                {
+                    uint32_t length;
+                    bool branchWaits = false;
+
+                    if (end - pc < 4)
+                    {
+                        return(false);
+                    }
+
+                    memcpy(&length, pc, 4);
+                    pc += 4;
+
+                    if (length > end - pc || !check(pc, pc + length, &branchWaits))
+                    {
+                        return(false);
+                    }
+
+                    waiting += branchWaits;
+                    pc += length;
+                }
+
+                if (waiting > 1)
+                {
+                    return(false);
+                }
+
+                waited = waited || waiting > 0;
+            }
+
+            else if (o == 0 || o > (uint8_t)op::goal || end - pc < argc[o] * 4)
+            {
+                return(false);
+            }
+
+            else
+            {
+                float a[maxArgs];
+                memcpy(a, pc, argc[o] * 4);
+
+                if (!validArgs((op)o, a))
+                {
+                    return(false);
+                }
+
+                waited = waited || o == (uint8_t)op::waitReady || o == (uint8_t)op::waitIndex;
+                pc += argc[o] * 4;
+            }
+        }
+
+        if (waits != nullptr)
+        {
+            *waits = waited;
+        }
+
+        return(true);
+    }
+
+    // reads and checks a compiled file, code is left empty if it isn't one
+    bool load(const char * file, std::vector<uint8_t> & code)
+    {
+        code.clear();
+        FILE * f = fopen(file, "rb");
+
+        if (f == nullptr)
+        {
+            return(false);
+        }
+
+        char magic[4];
+        uint32_t length = 0;
+        bool ok = fread(magic, 1, 4, f) == 4 && memcmp(magic, "AUT1", 4) == 0 && fread(&length, 4, 1, f) == 1;
+
+        // the length is only trusted as far as the file goes, so a bad one can't ask for more memory than that
+        long start = ftell(f);
+        ok = ok && fseek(f, 0, SEEK_END) == 0;
+        long size = ftell(f) - start;
+        ok = ok && size >= 0 && length <= (unsigned long)size && fseek(f, start, SEEK_SET) == 0;
+
+        if (ok)
+        {
+            code.resize(length);
+            ok = fread(code.data(), 1, length, f) == length && check(code.data(), code.data() + length);
+        }
+
+        fclose(f);
+
+        if (!ok)
+        {
+            code.clear();
+        }
+
+        return(ok);
+    }
+}
+
+#endif
@@ -6,6 +6,9 @@
 #define DR -362
 
 #include "global.hpp"
+#include "display.hpp"
+#include "profiler.hpp"
+#include "trace.hpp"
 #include "util.hpp"
 #include <cmath>
 #include <vector>
@@ -22,10 +25,27 @@ namespace chas
   void timedSpin(double target, double speed,double timeout);
   void velsUntilHeading(double rvolt, double lvolt, double heading, double tolerance, double timeout);
   void arcTurn(double theta, double radius, double timeout, util::pidConstants cons);
+
+  // - trace events
+  trace::event spinToTrace("chassis", "spinTo");
+  trace::event driveTrace("chassis", "drive");
+  trace::event autoDriveTrace("chassis", "autoDrive");
+  trace::event odomDriveTrace("chassis", "odomDrive");
+  trace::event moveToTrace("chassis", "moveTo");
+  trace::event moveToPoseTrace("chassis", "moveToPose");
+  trace::event timedSpinTrace("chassis", "timedSpin");
+  trace::event velsUntilHeadingTrace("chassis", "velsUntilHeading");
+  trace::event arcTurnTrace("chassis", "arcTurn");
+
+  /* set by shot::fire() while a volley is running and nan otherwise. autoDrive holds this heading instead of its own
+  so the robot keeps turning onto the aim point as it drives
+  */
+  util::atomicDouble aimHeading(NAN);
 }
 
 void chas::spinTo(double target, double timeout, util::pidConstants constants = util::pidConstants(3.7, 1.3, 26, 0.05, 2.4, 20))
 { 
+  trace::span traced(spinToTrace, target, timeout);
   // timers
   util::timer endTimer;
   util::timer timeoutTimer;
@@ -56,47 +76,51 @@ void chas::spinTo(double target, double timeout, util::pidConstants constants =
   // pid loop 
   while (!end)
   {
+    {
+      profiler::scope timed(profiler::chassis);
 
-    currHeading = robot::imu.degHeading();
-    int dir = -util::dirToSpin(target,currHeading);
+      currHeading = robot::imu.degHeading();
+      int dir = -util::dirToSpin(target,currHeading);
 
-    //pee
-    error = util::minError(target,currHeading);
+      //pee
+      error = util::minError(target,currHeading);
 
-    //eye
-    integral = error <= tolerance ? 0 : error < integralThreshold ? integral + error : integral;
+      //eye
+      integral = error <= tolerance ? 0 : error < integralThreshold ? integral + error : integral;
 
-    if(integral > maxIntegral)
-    {
-      integral = 0;
-    }
+      if(integral > maxIntegral)
+      {
+        integral = 0;
+      }
 
-    //dee
-    derivative = error - prevError;
-    prevError = error;
+      //dee
+      derivative = error - prevError;
+      prevError = error;
 
-    //end conditions
-    if (error >= tolerance)
-    {
-      endTimer.start();
-    }
+      //end conditions
+      if (error >= tolerance)
+      {
+        endTimer.start();
+      }
 
-    // end = endTimer.time() >= endTime ? true : timeoutTimer.time() >= timeout ? true : false;
+      // end = endTimer.time() >= endTime ? true : timeoutTimer.time() >= timeout ? true : false;
 
-    if(timeoutTimer.time()>= timeout)
-    {
-      break;
-    }
+      if(timeoutTimer.time()>= timeout)
+      {
+        break;
+      }
 
-    // spin motors
-    double rVel = dir * (error*kP + integral*kI + derivative*kD);
-    double lVel = dir * -1 * (error*kP + integral*kI + derivative*kD);
-    robot::chass.spinDiffy(rVel,lVel);
+      // spin motors
+      double rVel = dir * (error*kP + integral*kI + derivative*kD);
+      double lVel = dir * -1 * (error*kP + integral*kI + derivative*kD);
+      robot::chass.spinDiffy(rVel,lVel);
+    }
 
     pros::delay(10);
-    glb::controller.print(0, 0, "%f", error);
+    display::print(0, "%f", error);
     // glb::controller.print(0, 0, "%f", integral);
   }
+  profiler::chassis.idle();
   robot::chass.stop("b");
 } 
 
@@ -155,6 +179,7 @@ void chas::spinTo(double target, double timeout, util::pidConstants constants =
 
 void chas::drive(double target, double timeout, double tolerance)
 { 
+  trace::span traced(driveTrace, target, timeout);
   // timers
   util::timer timeoutTimer;
 
@@ -182,6 +207,7 @@ void chas::drive(double target, double timeout, double tolerance)
 
   while (!end)
   {
+    profiler::chassis.begin();
 
     double currRotation = robot::chass.getRotation();
 
@@ -209,14 +235,17 @@ void chas::drive(double target, double timeout, double tolerance)
     double lVel = (error*kP + integral*kI + derivative*kD);
     robot::chass.spinDiffy(rVel,lVel);
 
+    profiler::chassis.end();
     pros::delay(10);
     // glb::controller.print(0, 0, "%f", error);
   }
+  profiler::chassis.idle();
   robot::chass.stop("b");
 } 
 
 void chas::autoDrive(double target, double heading, double timeout, util::pidConstants lCons = util::pidConstants(0.3,0.2,2.4,5,30,1000), util::pidConstants acons = util::pidConstants(4, 0.7, 4, 0, 190, 20))
 {
+  trace::span traced(autoDriveTrace, target, heading);
   // timers
   util::timer timer = util::timer();
 
@@ -239,45 +268,55 @@ void chas::autoDrive(double target, double heading, double timeout, util::pidCon
 
   while (true)
   {
-    error = util::minError(heading, currHeading);
-    if (error < 0.5)
     {
-      acons.p = 0;
-      angularController.update(acons);
-    }
-
-    currHeading = robot::imu.degHeading();
-    rot = robot::chass.getRotation();
-
-    va = angularController.out(error);
-    vl = linearController.out(target - rot);
-    // vl = 0;
-    dir = -util::dirToSpin(heading,currHeading);
-
-    if (vl + std::abs(va) > 127)
-    {
-      vl = 127 - std::abs(va);
-    }
-
-    robot::chass.spinDiffy(vl + (dir * va * sgn),  vl - (dir * va * sgn));
-    // robot::chass.spinDiffy(vl,vl);
-
-    if(timer.time() >= timeout)
-    {
-      break;
+      profiler::scope timed(profiler::chassis);
+
+      // a volley steers onto its aim point, the usual settle on the heading is left to after it
+      double aimed = aimHeading;
+      double held = std::isnan(aimed) ? heading : aimed;
+
+      error = util::minError(held, currHeading);
+      if (error < 0.5 && std::isnan(aimed))
+      {
+        acons.p = 0;
+        angularController.update(acons);
+      }
+
+      currHeading = robot::imu.degHeading();
+      rot = robot::chass.getRotation();
+
+      va = angularController.out(error);
+      vl = linearController.out(target - rot);
+      // vl = 0;
+      dir = -util::dirToSpin(held,currHeading);
+
+      if (vl + std::abs(va) > 127)
+      {
+        vl = 127 - std::abs(va);
+      }
+
+      robot::chass.spinDiffy(vl + (dir * va * sgn),  vl - (dir * va * sgn));
+      // robot::chass.spinDiffy(vl,vl);
+
+      if(timer.time() >= timeout)
+      {
+        break;
+      }
     }
 
     pros::delay(10);
 
-    glb::controller.print(0, 0, "%f", util::minError(heading, currHeading));
+    display::print(0, "%f", util::minError(heading, currHeading));
   }
 
+  profiler::chassis.idle();
   robot::chass.stop("b");
 }
 
 
 void chas::odomDrive(double distance, double timeout, double tolerance)
 { 
+  trace::span traced(odomDriveTrace, distance, timeout);
   
   // resetting timers
   util::timer endTimer;
@@ -309,6 +348,7 @@ void chas::odomDrive(double distance, double timeout, double tolerance)
   // pid loop 
   while (!end)
   {
+    profiler::chassis.begin();
     
     // pee
     error = dist - (dist - util::distToPoint(glb::pos,target));
@@ -332,8 +372,10 @@ void chas::odomDrive(double distance, double timeout, double tolerance)
     double vel = (error*kP + integral*kI + derivative*kD);
     robot::chass.spin(vel);
 
+    profiler::chassis.end();
     pros::delay(10);
   }
+  profiler::chassis.idle();
   robot::chass.stop("b");
 }  
 
@@ -362,6 +404,7 @@ std::vector<double> chas::moveToVel(util::coordinate target, double lkp, double
 
 void chas::moveTo(util::coordinate target, double timeout, util::pidConstants lConstants, util::pidConstants rConstants, double rotationBias, double rotationScale, double rotationCut)
 {
+  trace::span traced(moveToTrace, target.x, target.y);
   //init
   util::timer timeoutTimer;
   double rotationVel, linearVel;
@@ -381,6 +424,8 @@ void chas::moveTo(util::coordinate target, double timeout, util::pidConstants lC
 
   while (timeoutTimer.time() < timeout)
   {
+    // this loop never sleeps, so its busy share is the whole time it runs
+    profiler::scope timed(profiler::chassis);
     //error
     linearError = distToPoint(glb::pos,target);
     currHeading =  robot::imu.degHeading(); //0-360
@@ -394,7 +439,7 @@ void chas::moveTo(util::coordinate target, double timeout, util::pidConstants lC
     rotationController.update(rConstants);  
     int dir = -util::dirToSpin(targetHeading,currHeading);
     double cre = cos(rotationError <= 90 ? util::dtr(rotationError) : PI/2);
-    glb::controller.print(0, 0, "%f,%f", rotationError, linearError);
+    display::print(0, "%f,%f", rotationError, linearError);
     // glb::controller.print(0, 0, "%f,%f", currHeading, targetHeading);
 
     rotationVel = dir * rotationController.out(rotationError);
@@ -406,6 +451,7 @@ void chas::moveTo(util::coordinate target, double timeout, util::pidConstants lC
     robot::chass.spinDiffy(rVel,lVel);
   }
 
+  profiler::chassis.idle();
   robot::chass.stop("b");
 }
 
@@ -413,6 +459,7 @@ void chas::moveTo(util::coordinate target, double timeout, util::pidConstants lC
 // void moveToPosePID(util::coordinate target, double finalHeading, double initialBias, double finalBias, double timeout, double initialHeading = robot::imu.degHeading())
 void chas::moveToPose(util::bezier curve, double timeout, double lkp, double rkp, double rotationBias)
 {
+  trace::span traced(moveToPoseTrace, timeout);
   
   // resolution in which to sample points along the curve
   int resolution = 100;
@@ -459,6 +506,7 @@ void chas::moveToPose(util::bezier curve, double timeout, double lkp, double rkp
 
 void chas::timedSpin(double target, double speed,double timeout)
 {
+  trace::span traced(timedSpinTrace, target, speed);
   // timers
   util::timer timeoutTimer;
 
@@ -495,6 +543,7 @@ void chas::timedSpin(double target, double speed,double timeout)
 
 void chas::velsUntilHeading(double rvolt, double lvolt, double heading, double tolerance, double timeout)
 {
+  trace::span traced(velsUntilHeadingTrace, heading, timeout);
   util::timer timeoutTimer;
 
   while (true)
@@ -510,6 +559,7 @@ void chas::velsUntilHeading(double rvolt, double lvolt, double heading, double t
 
 void chas::arcTurn(double theta, double radius, double timeout, util::pidConstants cons)
 {
+  trace::span traced(arcTurnTrace, theta, radius);
   util::timer timer;
   double curr;
   double currTime;
@@ -536,27 +586,31 @@ void chas::arcTurn(double theta, double radius, double timeout, util::pidConstan
 
   while (true)
   {
-    curr = glb::imu.get_heading();
-    currTime = timer.time();
+    {
+      profiler::scope timed(profiler::chassis);
+      curr = glb::imu.get_heading();
+      currTime = timer.time();
 
-    vel = controller.out(util::minError(theta, curr)) * util::dirToSpin(theta,curr);
+      vel = controller.out(util::minError(theta, curr)) * util::dirToSpin(theta,curr);
 
-    vel = std::abs(vel) >= 127 ? (127 * util::sign(vel)) : vel;
+      vel = std::abs(vel) >= 127 ? (127 * util::sign(vel)) : vel;
 
-    rvel = (2 * vel) / (ratio+1);
-    lvel = ratio * rvel;
+      rvel = (2 * vel) / (ratio+1);
+      lvel = ratio * rvel;
 
-    robot::chass.spinDiffy(rvel, lvel);
+      robot::chass.spinDiffy(rvel, lvel);
     
-    glb::controller.print(0, 0, "%f", util::minError(theta, curr));
+      display::print(0, "%f", util::minError(theta, curr));
 
-    if(currTime >= timeout)
-    {
-      break;
+      if(currTime >= timeout)
+      {
+        break;
+      }
     }
 
     pros::delay(10);
   }
+  profiler::chassis.idle();
   robot::chass.stop("b");
 }
 
@@ -0,0 +1,100 @@
+#ifndef __DISPLAY__
+#define __DISPLAY__
+
+#include "main.h"
+#include "global.hpp"
+#include "pros/rtos.hpp"
+#include <atomic>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+/* controller screen. the controller only takes one update about every 50ms and controller.print blocks the caller, so
+loops just print() into a shadow buffer and run() sends whatever line changed on its own schedule. a line posted a
+hundred times between sends only goes out once, with the latest value
+*/
+namespace display
+{
+    const int rows = 3;
+    const int width = 19;
+    const int period = 50;
+
+    // stored as words so any task can post without a lock. a read that lands mid post just gets resent next cycle
+    const int words = (width + 4) / 4;
+    std::atomic<uint32_t> pending[rows][words];
+    char shown[rows][words * 4];
+
+    void post(int row, const char * text)
+    {
+        char padded[words * 4];
+        int length = strnlen(text, width);
+
+        // pad with spaces so a shorter value covers the old one
+        memcpy(padded, text, length);
+        memset(padded + length, ' ', sizeof(padded) - length);
+        padded[width] = '\0';
+
+        for (int i = 0; i < words; i++)
+        {
+            uint32_t word;
+            memcpy(&word, padded + i * 4, 4);
+            pending[row][i].store(word, std::memory_order_relaxed);
+        }
+    }
+
+    void print(int row, const char * format, ...)
+    {
+        if (row < 0 || row >= rows)
+        {
+            return;
+        }
+
+        char text[width + 1];
+        va_list args;
+        va_start(args, format);
+        vsnprintf(text, sizeof(text), format, args);
+        va_end(args);
+
+        post(row, text);
+    }
+
+    void clear(int row)
+    {
+        print(row, "");
+    }
+
+    void run()
+    {
+        int next = 0;
+
+        while (true)
+        {
+            // round robin so a line that changes every loop can't starve the others
+            for (int i = 0; i < rows; i++)
+            {
+                int row = (next + i) % rows;
+                char text[words * 4];
+
+                for (int j = 0; j < words; j++)
+                {
+                    uint32_t word = pending[row][j].load(std::memory_order_relaxed);
+                    memcpy(text + j * 4, &word, 4);
+                }
+
+                if (text[0] != '\0' && memcmp(text, shown[row], width) != 0)
+                {
+                    text[width] = '\0';
+                    glb::controller.set_text(row, 0, text);
+                    memcpy(shown[row], text, sizeof(text));
+                    next = row + 1;
+                    break;
+                }
+            }
+
+            pros::delay(period);
+        }
+    }
+}
+
+#endif
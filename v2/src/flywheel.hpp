@@ -2,30 +2,278 @@
 #define __FLYWHEEL__
 
 #include "global.hpp"
+#include "display.hpp"
+#include "profiler.hpp"
+#include "telemetry.hpp"
+#include "trace.hpp"
 #include "util.hpp"
 #include <algorithm> 
+#include <atomic>
 #include <cmath>
+#include <cstdio>
 #include <numeric>
 #include <vector>
 
 namespace flywheel
 {
-    double target;
-    double gError;
-    int ff;
+    // - commands, written by any task
+    util::atomicDouble target;
+    util::atomicDouble openLoop;
+    std::atomic<int> ff(-1);
+
+    // - status, published by spin() once per tick
+    struct state
+    {
+        double target, speed, accel, error, voltage;
+        int shots;
+        bool recovering;
+    };
+
+    util::snapshot<state> status;
+
+    const uint16_t speedLog = telemetry::define("flywheel", "speed,target,voltage");
+    const uint16_t shotLog = telemetry::define("shot", "dip,speed,shots");
+
+    // one span per ff mode, a is the mode and b the target when it started
+    trace::event modeTrace("flywheel", "mode");
+
+    // - readiness
+    // abs error of the last historySize ticks, newest at historyIndex
+    const int historySize = 64;
+    double errorHistory[historySize];
+    int historyIndex;
+
+    /* one task can wait on the flywheel at a time, waiting is set last so the other fields are valid when spin sees
+    it. waiter is only a handle, so it has to be cleared with cancelWait() before that task can be deleted
+    */
+    std::atomic<bool> waiting(false);
+    std::atomic<pros::task_t> waiter(nullptr);
+    double readyTolerance;
+    int readyHold;
     
-    double voltageOut(double kp, double kv, double ki, double integral, double target, double error, double deadband)
+    // - gain schedule
+    // voltage per rpm measured at a free spinning flywheel
+    const double nominalKv = 0.1913474101312919;
+
+    // under target the p term is scaled down so it doesnt overshoot on the way back, far above target it coasts
+    const double belowScale = 0.7;
+    const double coastScale = 1/1.5;
+
+    /* flywheel feedforward, voltage = ks * sign(rpm) + kv * rpm + ka * rpm/s. defaults to the old single kv until
+    characterize() has been run and the fitted constants are put in the config file
+    */
+    struct feedforward
+    {
+        double ks, kv, ka;
+    };
+
+    feedforward model{0, nominalKv, 0};
+
+    // how fast the ka term tries to close the error inside the deadband, in seconds
+    const double responseTime = 0.15;
+
+    // target changes faster than this, in rpm/s, are steps rather than ramps
+    const double maxTargetAccel = 1500;
+
+    double feedforwardOut(double rpm, double rpmPerSec)
+    {
+        if (rpm == 0)
+        {
+            return 0;
+        }
+
+        return model.ks * util::sign(rpm) + model.kv * rpm + model.ka * rpmPerSec;
+    }
+
+    struct gains
+    {
+        double rpm, kp, ki, kv, deadband;
+    };
+
+    /* rows have to be sorted by rpm, gains between rows are linearly interpolated and targets past either end use
+    the end row. can be overwritten at startup from a file on the sd card with loadSchedule()
+    */
+    std::vector<gains> schedule
+    {
+        {350, 4, 0.07, nominalKv, 40},
+        {400, 14, 0.7, nominalKv, 50},
+        {450, 14, 0.7, nominalKv, 50},
+        {470, 14, 0.7, nominalKv, 50},
+        {510, 6, 0.01, nominalKv, 30},
+        {580, 14, 0.09, nominalKv, 40},
+    };
+
+    gains scheduled(double rpm)
+    {
+        if (rpm <= schedule.front().rpm)
+        {
+            return schedule.front();
+        }
+
+        for (int i = 1; i < schedule.size(); i++)
+        {
+            if (rpm <= schedule[i].rpm)
+            {
+                gains lo = schedule[i-1];
+                gains hi = schedule[i];
+                double t = (rpm - lo.rpm) / (hi.rpm - lo.rpm);
+
+                return gains{rpm, lo.kp + (hi.kp - lo.kp) * t, lo.ki + (hi.ki - lo.ki) * t, lo.kv + (hi.kv - lo.kv) * t, lo.deadband + (hi.deadband - lo.deadband) * t};
+            }
+        }
+
+        return schedule.back();
+    }
+
+    /* one row per line as "rpm kp ki kv deadband", lines starting with # are ignored. a line "ff ks kv ka" sets the
+    feedforward model. nothing is replaced unless the whole file parses
+    */
+    bool loadSchedule(const char* path = "/usd/flywheel.cfg")
+    {
+        FILE* file = fopen(path, "r");
+
+        if (file == NULL)
+        {
+            return false;
+        }
+
+        std::vector<gains> rows;
+        feedforward ffModel = model;
+        char line[128];
+        bool valid = true;
+
+        while (fgets(line, sizeof(line), file) != NULL)
+        {
+            gains row;
+            char first;
+
+            // blank lines, including ones that are only whitespace, and comments
+            if (sscanf(line, " %c", &first) != 1 || first == '#')
+            {
+                continue;
+            }
+
+            if (first == 'f')
+            {
+                if (sscanf(line, " ff %lf %lf %lf", &ffModel.ks, &ffModel.kv, &ffModel.ka) != 3)
+                {
+                    valid = false;
+                    break;
+                }
+
+                continue;
+            }
+
+            if (sscanf(line, "%lf %lf %lf %lf %lf", &row.rpm, &row.kp, &row.ki, &row.kv, &row.deadband) != 5)
+            {
+                valid = false;
+                break;
+            }
+
+            rows.push_back(row);
+        }
+
+        fclose(file);
+
+        if (!valid || rows.empty())
+        {
+            return false;
+        }
+
+        std::sort(rows.begin(), rows.end(), [](const gains & a, const gains & b) { return a.rpm < b.rpm; });
+        schedule = rows;
+        model = ffModel;
+        return true;
+    }
+    
+    // how long the error has stayed under tolerance, only as far back as the history goes
+    int inRangeFor(double tolerance)
+    {
+        for (int i = 0; i < historySize; i++)
+        {
+            if (errorHistory[(historyIndex - i + historySize) % historySize] >= tolerance)
+            {
+                return i * 10;
+            }
+        }
+
+        return historySize * 10;
+    }
+
+    /* forgets the waiting task without waking it. the script calls this before deleting tasks that may be blocked in
+    waitReady, otherwise spin() would notify a freed task
+    */
+    void cancelWait()
+    {
+        waiting = false;
+        waiter = nullptr;
+    }
+
+    /* blocks the calling task until the flywheel has been within tolerance for hold ms or until timeout. the flywheel
+    task wakes the caller the tick it becomes ready so nothing has to poll. returns how long it waited, or -1 on timeout.
+    hold can't be longer than the history, longer holds are cut to it
+    */
+    int waitReady(double tolerance, int hold, int timeout)
+    {
+        util::timer timer;
+        hold = std::min(hold, historySize * 10);
+
+        // clear a notification left over from an earlier timed out wait
+        pros::Task::notify_take(true, 0);
+
+        waiter = pros::c::task_get_current();
+        readyTolerance = tolerance;
+        readyHold = hold;
+        waiting = true;
+
+        bool ready = pros::Task::notify_take(true, timeout) > 0;
+        cancelWait();
+
+        return ready ? timer.time() : -1;
+    }
+
+    // - shot detection
+    // a launch shows up as a sharp negative acceleration in the estimate along with a drop below target
+    const double shotAccel = -800;
+    const double shotDrop = 8;
+    const int shotLockout = 120;
+    const int maxBoostTime = 400;
+
+    // boost is cut when the wheel is predicted to reach target this far ahead, in seconds
+    const double boostLookahead = 0.03;
+
+    /* open loop time constant of the wheel in seconds, for a first order wheel ka = kv * tau. only used to size the
+    recovery boost until fwfit.py's ka is in the config
+    */
+    const double assumedTau = 0.4;
+
+    /* voltage needed to win back the dip within responseTime. without a fitted ka the acceleration term is sized from
+    kv and assumedTau, so a bigger dip still gets a bigger boost
+    */
+    double recoveryOut(double target, double dip)
+    {
+        double ka = model.ka > 0 ? model.ka : model.kv * assumedTau;
+
+        return std::min(127.0, feedforwardOut(target, 0) + ka * dip / responseTime);
+    }
+
+    /* the scheduled kv converts the pi correction from rpm to voltage, the rest comes from the feedforward model. the
+    ka term asks for enough acceleration to close the error within responseTime
+    */
+    double voltageOut(gains g, double integral, double target, double targetAccel, double error)
     {
-        if (std::abs(error) < deadband)
+        if (std::abs(error) < g.deadband)
         {
+            double base = feedforwardOut(target, targetAccel) + model.ka * error / responseTime;
+
             if(error > 0)
             {
-                return (target + error * kp + integral * ki) * kv;
+                return base + (error * g.kp + integral * g.ki) * g.kv;
             }
 
             else
             {
-                return (target + (error * 0.7) * kp + integral * ki) * kv;
+                return base + ((error * belowScale) * g.kp + integral * g.ki) * g.kv;
             }
         }
 
@@ -37,66 +285,110 @@ namespace flywheel
 
         else
         {
-            return (target/1.5) * kv;
+            return feedforwardOut(target, 0) * coastScale;
         }
     }
 
     void spin()
     {
-        const int velAverageSize = 30;
-        const double kv = 0.1913474101312919;
         const double integralThreshold = 5;
-        double ki;
-        double kp;
-        util::movingAverage velAverage = util::movingAverage(velAverageSize);
+        gains g = scheduled(0);
+        util::kalman velFilter = util::kalman(1/nominalKv, 0.25, 4, 200000, 25);
         util::timer forwardTimer;
         util::timer postForward;
-        double speed;
         double error;
         double absError;
-        double voltage;
-        double integral;
-        double deadband;
+        double voltage = 0;
+        double integral = 0;
+        double prevTarget = 0;
+        double targetAccel;
+        double dip = 0;
+        double setpoint;
+        double speed;
+        double accel;
+        int shots = 0;
+        uint32_t lastFrame = 0;
+        bool recovering = false;
+        util::timer shotTimer;
+        int mode = ff;
+        modeTrace.begin(mode, target);
+
+        // nothing has been measured yet, so nothing counts as in range
+        std::fill(errorHistory, errorHistory + historySize, HUGE_VAL);
 
         while (true)
         {
-            //velocity sliding average
-            velAverage.push(robot::flywheel.getSpeed());
-            // speed = velAverage.simpleAverage();
-            speed = velAverage.expAverage();
+            profiler::flywheel.begin();
+            setpoint = target;
 
-            error = target - speed;
-            absError = std::abs(error);
-            gError = absError;
+            /* velocity estimate, both motors are fused as separate measurements. the motors saturate at 127 so the
+            model is only fed what they actually applied
+            */
+            velFilter.predict(voltage > 127 ? 127 : voltage < -127 ? -127 : voltage);
+
+            // the sensors task ticks at the same rate but not in step, a frame already fused is only predicted across
+            sensors::frame f = sensors::read();
 
-            if (target < 390)
+            if (f.time != lastFrame)
             {
-                kp = 4;
-                ki = 0.07;
-                deadband = 40;
+                lastFrame = f.time;
+
+                for (int i = 0; i < robot::flywheel.count(); i++)
+                {
+                    velFilter.correct(robot::flywheel.getSpeed(f, i));
+                }
             }
 
-            else if (target < 490)
+            speed = velFilter.velocity();
+            accel = velFilter.acceleration();
+
+            error = setpoint - speed;
+            absError = std::abs(error);
+
+            historyIndex = (historyIndex + 1) % historySize;
+            errorHistory[historyIndex] = absError;
+
+            if (waiting && inRangeFor(readyTolerance) >= readyHold)
             {
-                kp = 14;
-                ki = 0.7;
-                deadband = 50;
+                pros::task_t task = waiter.exchange(nullptr);
+                waiting = false;
+
+                if (task != nullptr)
+                {
+                    pros::c::task_notify(task);
+                }
             }
 
-            else if(target < 530)
+            g = scheduled(setpoint);
+            targetAccel = (setpoint - prevTarget) / 0.01;
+
+            // a preset change is a step the wheel cant follow, only smooth ramps get the ka feedforward
+            if (std::abs(targetAccel) > maxTargetAccel)
             {
-                kp = 6;
-                ki = 0.01;
-                deadband = 30;
+                targetAccel = 0;
             }
 
-            else
+            prevTarget = setpoint;
+
+            // shot detection and recovery
+            if (!recovering && setpoint > 0 && accel < shotAccel && error > shotDrop && shotTimer.time() > shotLockout)
             {
-                kp = 14;
-                ki = 0.09;
-                deadband = 40;
+                shots++;
+                recovering = true;
+                dip = error;
+                shotTimer.start();
+                telemetry::record(shotLog, dip, speed, shots);
             }
 
+            if (recovering)
+            {
+                dip = std::max(dip, error);
+
+                if (error - accel * boostLookahead <= 0 || shotTimer.time() > maxBoostTime)
+                {
+                    recovering = false;
+                }
+            }
 
             if(absError < integralThreshold)
             {
@@ -115,12 +407,19 @@ namespace flywheel
             {
                 integral = 0;
             }
+
+            if (ff != mode)
+            {
+                modeTrace.end(mode);
+                mode = ff;
+                modeTrace.begin(mode, setpoint);
+            }
             
-            switch (ff)
+            switch (mode)
             {
                 case -1:
 
-                    voltage = voltageOut(kp, kv, ki, integral, target, error, deadband);
+                    voltage = recovering ? recoveryOut(setpoint, dip) : voltageOut(g, integral, setpoint, targetAccel, error);
                     forwardTimer.start();
                     break;
 
@@ -128,6 +427,11 @@ namespace flywheel
                     voltage = 127;
                     break;
 
+                // open loop, used by characterize()
+                case 2:
+                    voltage = openLoop;
+                    break;
+
                 case 1:
                     if(forwardTimer.time() >= 0)
                     {
@@ -137,6 +441,7 @@ namespace flywheel
                         if(forwardTimer.time() >= 500)
                         {
                             robot::flywheel.stop("c");
+                            voltage = 0;
                             // for (int i = 0; i < 7; i ++)
                             // {
                             //     printf("%f,%f,", speed, 0.0);
@@ -148,21 +453,6 @@ namespace flywheel
                         }
                     }
                     break;
-                
-                case 3:
-                    if(forwardTimer.time() >= 80)
-                    {
-                        if(forwardTimer.time() >= 600)
-                        {
-                            ff = -1;
-                        }
-
-                        else
-                        {
-                            voltage = 127;
-                        }
-                    }
-                    break;
             }
 
             // glb::controller.print(1, 1, "%f", voltage);
@@ -190,7 +480,10 @@ namespace flywheel
 
             // voltage = voltageOut(kp, kv, ki, integral, target, error, deadband);
             robot::flywheel.spin(voltage);
+            status.write(state{setpoint, speed, accel, error, voltage, shots, recovering});
+            telemetry::record(speedLog, speed, setpoint, voltage);
             
+            profiler::flywheel.end();
             pros::delay(10);
             // printf("%f,", speed);
             // if (ff != -1)
@@ -206,6 +499,71 @@ namespace flywheel
             // printf("%f,%f,", speed,integral);
         }
     }
+
+    /* drives the flywheel open loop and logs time, voltage and velocity to the sd card for tools/fwfit.py. a slow ramp
+    gives ks and kv, the steps afterwards give ka. the robot has to be left alone for about 40 seconds
+    */
+    void characterize()
+    {
+        FILE* file = fopen("/usd/fwchar.csv", "w");
+
+        if (file == NULL)
+        {
+            display::print(0, "no sd card");
+            return;
+        }
+
+        fprintf(file, "time,voltage,velocity\n");
+
+        util::timer timer;
+        ff = 2;
+
+        auto sample = [&](double volts)
+        {
+            openLoop = volts;
+            fprintf(file, "%d,%f,%f\n", timer.time(), volts, robot::flywheel.getSpeed());
+            pros::delay(10);
+        };
+
+        auto settle = [&]()
+        {
+            util::timer settleTimer;
+
+            while (robot::flywheel.getSpeed() > 10 && settleTimer.time() < 8000)
+            {
+                sample(0);
+            }
+        };
+
+        // quasistatic ramp, 5 move() units a second
+        for (double volts = 0; volts <= 127; volts += 0.05)
+        {
+            sample(volts);
+        }
+
+        settle();
+
+        // steps
+        const double steps[] = {40, 80, 127};
+
+        for (double volts : steps)
+        {
+            util::timer stepTimer;
+
+            while (stepTimer.time() < 3000)
+            {
+                sample(volts);
+            }
+
+            settle();
+        }
+
+        openLoop = 0;
+        ff = -1;
+        target = 0;
+        fclose(file);
+        display::print(0, "char done");
+    }
 }
 
 
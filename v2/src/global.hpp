@@ -4,7 +4,10 @@
 
 #include "main.h"
 #include "pros/adi.hpp"
+#include "battery.hpp"
+#include "sensors.hpp"
 #include "util.hpp"
+#include "velocity.hpp"
 #include <string>
 #include <vector>
 
@@ -45,6 +48,8 @@ namespace glb
 
     // variables
     util::coordinate pos = util::coordinate(0,0);
+    // written by odom(), read from other tasks so it is published whole
+    util::snapshot<util::coordinate> vel;
     util::timer matchTimer(1);
     // double dl;
     // double dr;
@@ -66,6 +71,15 @@ class group::mtrs
     protected:
  
         std::vector<pros::Motor> motors;
+        std::vector<int> slots;     // where each motor is in a sensors::frame
+        std::vector<double> zero;   // position each motor had when reset(), until a frame after it comes in
+        uint32_t zeroedAt = 0;      // time of the last frame sampled before reset()
+
+        // frames from before the last reset() still hold the old position, so it is taken off here
+        double position(const sensors::frame & f, int index)
+        {
+            return(f.time <= zeroedAt ? f.position[slots[index]] - zero[index] : f.position[slots[index]]);
+        }
         std::string name;
         int size;
 
@@ -73,10 +87,19 @@ class group::mtrs
 
         // mtrs(const std::initializer_list<pros::Motor> & motorsList)
 
-        mtrs(const std::vector<pros::Motor> & motorsList, std::string title) : motors(motorsList) , name(title), size(motorsList.size()){}
+        mtrs(const std::vector<pros::Motor> & motorsList, std::string title) : motors(motorsList) , name(title), size(motorsList.size())
+        {
+            for (int i=0; i < size; i++)
+            {
+                slots.push_back(sensors::add(motors[i]));
+                zero.push_back(0);
+            }
+        }
 
         void spin(double volts = 127)
         {
+            volts = battery::compensate(volts);
+
             for (int i=0; i < size; i++)
             {
                 motors[i].move(volts);
@@ -105,36 +128,110 @@ class group::mtrs
             }
         }
 
+        // - sensor getters, all read the last sensors::frame
         double getSpeed()
         {
+            sensors::frame f = sensors::read();
             double vel = 0;
 
             for (int i=0; i < size; i++)
             {
-                vel += motors[i].get_actual_velocity();
+                vel += f.velocity[slots[i]];
             }
             
             return(vel/size);
         }
 
+        double getSpeed(int index)
+        {
+            return(sensors::velocity(slots[index]));
+        }
+
+        // from a frame the caller already has, so several motors can be read from the same one
+        double getSpeed(const sensors::frame & f, int index)
+        {
+            return(f.velocity[slots[index]]);
+        }
+
+        int count()
+        {
+            return(size);
+        }
+
         double getRotation()
         {
+            sensors::frame f = sensors::read();
             double rotation = 0;
 
             for (int i=0; i < size; i++)
             {
-                rotation += motors[i].get_position();
+                rotation += position(f, i);
             }
             
             return(rotation/size);
         }
 
+        // total draw in mA
+        double getCurrent()
+        {
+            sensors::frame f = sensors::read();
+            double current = 0;
+
+            for (int i=0; i < size; i++)
+            {
+                current += f.current[slots[i]];
+            }
+
+            return(current);
+        }
+
+        double getCurrent(int index)
+        {
+            return(sensors::current(slots[index]));
+        }
+
+        // hottest motor
+        double getTemperature()
+        {
+            sensors::frame f = sensors::read();
+            double temperature = 0;
+
+            for (int i=0; i < size; i++)
+            {
+                temperature = f.temperature[slots[i]] > temperature ? f.temperature[slots[i]] : temperature;
+            }
+
+            return(temperature);
+        }
+
+        double getTemperature(int index)
+        {
+            return(sensors::temperature(slots[index]));
+        }
+
+        double getVoltage(int index)
+        {
+            return(sensors::voltage(slots[index]));
+        }
+
+        // mA, the motors start at 2500
+        void setCurrentLimit(int index, int limit)
+        {
+            motors[index].set_current_limit(limit);
+        }
+
+        // doesnt wait for a new frame, getRotation() takes the old position off until one comes in
         void reset()
         {
+            sensors::frame f = sensors::read();
+
             for (int i=0; i < size; i++)
             {
+                zero[i] = f.position[slots[i]];
                 motors[i].set_zero_position(0);
             }
+
+            zeroedAt = f.time;
         }
 
         void spinDist(double deg, double vel, std::string brakeMode)
@@ -164,31 +261,86 @@ class group::mtrs
 
 class group::chassis : public group::mtrs
 {
+    private:
+
+        velocity::side left = velocity::side(velocity::leftLog);
+        velocity::side right = velocity::side(velocity::rightLog);
+
+        void spinRaw(double lvolt, double rvolt)
+        {
+            int half = size/2;
+
+            for (int i=0; i < half; i++)
+            {
+                motors[i].move(lvolt);
+                motors[i + half].move(rvolt);
+            }
+        }
+
+        double sideSpeed(const sensors::frame & f, int start)
+        {
+            double vel = 0;
+            int half = size/2;
+
+            for (int i = 0; i < half; i++)
+            {
+                vel += f.velocity[slots[i + start]];
+            }
+
+            return(vel/half);
+        }
 
     public:
 
+        /* the -127 to 127 the primitives give is read as a fraction of velocity::topSpeed and held with spinVel(). off
+        by default since the primitives were tuned as voltages, only set it around primitives retuned for it
+        */
+        bool closedLoop = false;
+
         // chassis(const std::initializer_list<pros::Motor> & motors) : mtrs(motors){}
         chassis(const std::vector<pros::Motor> & motorsList, std::string title) : mtrs(motorsList,title){}
 
-        void spinDiffy(double rvolt, double lvolt)
+        // the first half of the motors, the left side, gets the first argument
+        void spinDiffy(double lvolt, double rvolt)
         {
-            int half = size/2;
-
-            for (int i=0; i < half; i++)
+            if (closedLoop)
             {
-                motors[i].move(rvolt);
-                motors[i + half].move(lvolt);
+                spinVel(lvolt / 127 * velocity::topSpeed, rvolt / 127 * velocity::topSpeed);
+                return;
             }
+
+            spinRaw(battery::compensate(lvolt), battery::compensate(rvolt));
+        }
+
+        void spin(double volts = 127)
+        {
+            spinDiffy(volts, volts);
+        }
+
+        // wheel in/s per side, same order as spinDiffy
+        void spinVel(double lips, double rips)
+        {
+            sensors::frame f = sensors::read();
+
+            spinRaw(left.out(lips, velocity::ips(sideSpeed(f, 0))), right.out(rips, velocity::ips(sideSpeed(f, size/2))));
+        }
+
+        void stop(std::string brakeMode)
+        {
+            left.reset();
+            right.reset();
+            mtrs::stop(brakeMode);
         }
 
         double getLeft()
         {
+            sensors::frame f = sensors::read();
             double dl = 0;
             int half = size/2;
             
             for (int i=0; i < half; i++)
             {
-                dl += motors[i].get_position();
+                dl += position(f, i);
             }
             
             return(dl/half);
@@ -196,12 +348,13 @@ class group::chassis : public group::mtrs
 
         double getRight()
         {
+            sensors::frame f = sensors::read();
             double dr = 0;
             int half = size/2;
             
             for (int i = 0; i < half; i++)
             {
-                dr+= motors[i+half].get_position();
+                dr+= position(f, i + half);
             }
 
             return(dr/half);
@@ -292,6 +445,11 @@ namespace robot
     group::pis angler(anglerPistons, false, "angler");
     group::imu imu(glb::imu, 0);
 
+    /* held by whichever task is indexing or firing discs, nothing else moves the intake or writes intake::status
+    meanwhile. shot::fire keeps it for a whole volley, opcontrol() takes it back from an auton that was cut off
+    */
+    util::owner intakeOwner;
+
 } 
 
 #endif
\ No newline at end of file
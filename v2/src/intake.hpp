@@ -1,14 +1,25 @@
+#ifndef __INTAKE__
+#define __INTAKE__
+
 #include "global.hpp"
+#include "display.hpp"
 #include "flywheel.hpp"
 #include "pros/rtos.hpp"
+#include "telemetry.hpp"
+#include "trace.hpp"
 #include "util.hpp"
 
 namespace intake
 {
-    util::timer inRange;
+    // - trace events, ready is the part of each shot spent waiting on the flywheel
+    trace::event waitIndexTrace("intake", "waitIndex");
+    trace::event readyTrace("intake", "ready");
+    trace::event toggleTrace("intake", "toggle");
 
     void index(int num)
     {
+        robot::intakeOwner.take(TIMEOUT_MAX);
+
         for (int i = 0; i < num; i++)
         {
             robot::intake.spin(-50);
@@ -16,6 +27,8 @@ namespace intake
             robot::intake.stop("b");
             pros::delay(100);
         }
+
+        robot::intakeOwner.give();
     }
     
     void hardToggle()
@@ -29,47 +42,58 @@ namespace intake
         // pros::delay(300);
         robot::chass.stop("b");
     }
-    void waitIndex(int num, int tolerance = 5, int ff = -1, int time = 50, int ffTime = 0)
+    // how long each shot waited on the flywheel, -1 if it timed out and fired anyway
+    const uint16_t waitLog = telemetry::define("intake.wait", "shot,waited,indexed");
+    int lastWait = 0;
+
+    // - status, only written while holding robot::intakeOwner so there is one writer at a time
+    struct state
+    {
+        int indexed;
+        int lastWait;
+        bool indexing;
+    };
+
+    util::snapshot<state> status;
+    int indexed = 0;
+
+    void waitIndex(int num, int tolerance = 5, int ff = -1, int time = 50, int ffTime = 0, int timeout = 3000)
     {
+        trace::span traced(waitIndexTrace, num);
+        robot::intakeOwner.take(TIMEOUT_MAX);
+
         for (int i = 0; i < num; i++)
         {
-            while (true)
+            status.write(state{indexed, lastWait, true});
+            readyTrace.begin(i + 1);
+            int waited = flywheel::waitReady(tolerance, time, timeout);
+            readyTrace.end(i + 1, waited);
+            lastWait = waited;
+            telemetry::record(waitLog, i + 1, waited, indexed);
+
+            if (i == num-1)
             {
-                if(flywheel::gError < tolerance)
-                {
+                flywheel::ff = ff;
+                pros::delay(ffTime);
+                robot::intake.spin(-80);
+                pros::delay(200);
+            }
 
-                    if(inRange.time() >= time)
-                    {
-                        if (i == num-1)
-                        {
-                            flywheel::ff = ff;
-                            pros::delay(ffTime);
-                            robot::intake.spin(-80);
-                            pros::delay(200);
-                            inRange.start();
-                        }
-
-                        else
-                        {
-                            flywheel::ff = ff;
-                            pros::delay(ffTime);
-                            robot::intake.spin(-50);        
-                            pros::delay(200);
-                            robot::intake.stop("b");
-                            pros::delay(250);
-                            inRange.start();
-                        }
-
-                        break;
-                    }
-                }
-                
-                else
-                {
-                    inRange.start();
-                }
+            else
+            {
+                flywheel::ff = ff;
+                pros::delay(ffTime);
+                robot::intake.spin(-50);        
+                pros::delay(200);
+                robot::intake.stop("b");
+                pros::delay(250);
             }
+
+            indexed++;
         }
+
+        status.write(state{indexed, lastWait, false});
+        robot::intakeOwner.give();
     }
 
     // void index(int num)
@@ -174,13 +198,14 @@ namespace intake
 
     void toggle(bool ym, double timeLimit = 1000)
     {
+        trace::span traced(toggleTrace, glb::red);
         util::timer timer;
 
         glb::optical.set_led_pwm(100);
         robot::chass.spin(45);
         pros::delay(400);
         double initColor = glb::optical.get_hue();
-        glb::controller.print(1, 1, "%f", glb::optical.get_hue());
+        display::print(1, " %f", glb::optical.get_hue());
         // robot::chass.stop("b");
         bool initRed = initColor >= 60 ? false : true;
 
@@ -242,8 +267,4 @@ namespace intake
 
 }
 
-
-
-
-
-
+#endif
@@ -7,9 +7,17 @@
 #include "pros/rtos.hpp"
 #include "util.hpp"
 #include "flywheel.hpp"
+#include "shot.hpp"
+#include "autoaim.hpp"
+#include "display.hpp"
+#include "profiler.hpp"
+#include "trace.hpp"
+#include "stream.hpp"
+#include "budget.hpp"
 
 // - globals
 void (*auton)();
+trace::event autonTrace("auton", "run");
 // bool control = true;
 
 // vision::signature SIG_1 (1, 1033, 1937, 1486, -4715, -4095, -4404, 3.000, 0);
@@ -29,36 +37,80 @@ void initialize()
 	glb::controller.clear();
 	pros::vision_signature_s_t BLUE_GOAL = pros::Vision::signature_from_utility (2, -2307, -1597, -1952, 8373, 9299, 8836, 8.200, 1);
 	pros::vision_signature_s_t RED_GOAL = pros::Vision::signature_from_utility(1, 541, 11747, 6144, -841, 845, 2, 0.800, 0);
-	glb::vision.set_signature(2, &BLUE_GOAL);
-	glb::vision.set_signature(1, &RED_GOAL);
+	glb::vision.set_signature(aim::blueSig, &BLUE_GOAL);
+	glb::vision.set_signature(aim::redSig, &RED_GOAL);
+
+	// - flywheel gains and vision range constants, without an sd card the built in schedule is kept and vision ranging is off
+	flywheel::loadSchedule();
+	aim::loadRange();
 
 	// - autSelector
 	auton = autonSelector();
+
+	// - a script auton is read off the card now rather than when the match starts
+	if (auton == script::fromCard && !script::load())
+	{
+		display::print(0, "no %s", script::path + 5);
+	}
 	
+	/* - serial telemetry for tools/plot.py. it turns cobs off, which the pros terminal can't read, so it is only built
+	with -DSERIAL_TELEMETRY added to the compiler flags
+	*/
+#ifdef SERIAL_TELEMETRY
+	stream::rate("odom", 20);
+	stream::start();
+#endif
+
 	// - tasks
+	sensors::start();
+	battery::start();
+	telemetry::start();
+	profiler::start();
 	pros::Task od(odom);
 	pros::Task fw(flywheel::spin);
+	pros::Task st(shot::track);
+	pros::Task sf(shot::fire);
+	pros::Task vt(aim::track);
+	budget::start();
+	pros::Task dp(display::run, TASK_PRIORITY_MIN + 1, TASK_STACK_DEPTH_DEFAULT, "display");
 
 	//-  fw initial vel
 	flywheel::target = 0;
 	
 }
 
-void disabled() {}
+void disabled() 
+{
+	// competition control deletes the auton task, it may have been blocked in flywheel::waitReady
+	script::stop();
+}
 
 void competition_initialize() {}
 
 void autonomous() 
 {
 	glb::match = false;
+
+	// the primitives' constants were tuned as voltages, an auton retuned for closed loop turns it on itself
+	robot::chass.closedLoop = false;
+	trace::span traced(autonTrace);
 	auton();
 }
 
 void opcontrol() 
 {
+	// the drivers are used to the stick being straight voltage
+	robot::chass.closedLoop = false;
+
+	// a volley or parallel branch the auton left behind would keep fighting the driver, and the auton task may have been ended holding the intake
+	shot::volley = 0;
+	flywheel::cancelWait();
+	script::stop();
+	robot::intakeOwner.give();
 
 	while (true) 
 	{
+		profiler::driver.begin();
 
 		// double dl = 0;
 		// double dr = 0;
@@ -88,7 +140,10 @@ void opcontrol()
 
 		else {felixControl();}
 
+		shot::applyAngler();
+
 		// printf("pros::delay(20);\n");
+		profiler::driver.end();
 		pros::delay(20);
 	}
 }
\ No newline at end of file
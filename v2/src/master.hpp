@@ -7,6 +7,7 @@
 #include "pros/rtos.hpp"
 #include "util.hpp"
 #include "autoaim.hpp"
+#include "shot.hpp"
 
 
 util::timer decelTimer; 
@@ -16,6 +17,14 @@ util::timer fowrardTimer;
 double prevSpeed;
 bool toggled;
 
+// any of the buttons used with L2 for flywheel presets
+bool presetHeld()
+{
+    return glb::controller.get_digital(pros::E_CONTROLLER_DIGITAL_L1) || glb::controller.get_digital(pros::E_CONTROLLER_DIGITAL_R1) ||
+        glb::controller.get_digital(pros::E_CONTROLLER_DIGITAL_R2) || glb::controller.get_digital(pros::E_CONTROLLER_DIGITAL_A) ||
+        glb::controller.get_digital(pros::E_CONTROLLER_DIGITAL_RIGHT);
+}
+
 void curvature(double iThrottle, double iCurvature, double iThreshold){
     if(std::fabs(iThrottle) <= iThreshold){
         robot::chass.spinDiffy(127*iCurvature,0-127*iCurvature);
@@ -71,7 +80,13 @@ void felixControl()
         glb::controller.rumble(".");
         robot::angler.toggle();
 
-        if(robot::angler.state)
+        // while tracking the table picks the rpm for the new angler state, a manual toggle turns the auto angler off
+        if(shot::tracking)
+        {
+            shot::autoAngler = false;
+        }
+
+        else if(robot::angler.state)
         {
             flywheel::target += 40;
             
@@ -86,75 +101,92 @@ void felixControl()
     if(glb::controller.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_RIGHT))
     {
         toggled = !toggled;
+        aim::recording = toggled;
     }
 
     if(std::abs(lStick) < 9 && std::abs(rStick) < 9 && decelTimer.time() <= 8000 && toggled)
     {
-        static util::pid pid(util::pidConstants(0.6, 0.1, 0, 0.1, 0.3, 1000), 1000);
-        pros::vision_object_s_t goal = glb::vision.get_by_sig(0, 2);
-        int x = goal.left_coord;
-        int error = 66-x;
-        // if(std::abs(error) < 1)
-        // {
-        //     error = 0;
-        // }
+        static util::pid pid(aim::constants, 1000);
+        aim::signature = aim::blueSig;
+        aim::target goal = aim::goal.read();
 
-        int vel = pid.out(error);
-        
-        robot::chass.spinDiffy(-vel, vel);
+        if(goal.visible)
+        {
+            // felix lines up on 66, two pixels left of the center autoAim() uses
+            int vel = pid.out(66 - goal.x);
+            robot::chass.spinDiffy(-vel, vel);
+        }
     }
 
     if(glb::controller.get_digital(pros::E_CONTROLLER_DIGITAL_L2))
     {
         doubleTap.start();
-        if(!robot::angler.state)
-        {
-            if(glb::controller.get_digital(pros::E_CONTROLLER_DIGITAL_L1))
-            {
-                flywheel::target = 350;
-            }
 
-            else if(glb::controller.get_digital(pros::E_CONTROLLER_DIGITAL_A))
-            {
-                flywheel::target = 580;
-            }
-        
-            else if(glb::controller.get_digital(pros::E_CONTROLLER_DIGITAL_R1))
-            {
-                flywheel::target = 470;
-            }
-
-            else if(glb::controller.get_digital(pros::E_CONTROLLER_DIGITAL_R2))
-            {
-                flywheel::target = 400;
-            }
-
-            else
-            {
-                flywheel::target = prevSpeed;
-            }
+        // L2 + B hands the rpm and angler to the shot table, L2 + a preset takes them back
+        if(glb::controller.get_digital(pros::E_CONTROLLER_DIGITAL_B))
+        {
+            shot::tracking = true;
+            shot::autoAngler = true;
         }
 
-        else
+        else if(presetHeld())
         {
-            if(glb::controller.get_digital(pros::E_CONTROLLER_DIGITAL_L1))
-            {
-                flywheel::target = 390;
-            }
+            shot::tracking = false;
+            shot::autoAngler = false;
+        }
 
-            else if(glb::controller.get_digital(pros::E_CONTROLLER_DIGITAL_R1))
+        // the table owns the rpm while tracking
+        if(!shot::tracking)
+        {
+            if(!robot::angler.state)
             {
-                flywheel::target = 530;
+                if(glb::controller.get_digital(pros::E_CONTROLLER_DIGITAL_L1))
+                {
+                    flywheel::target = 350;
+                }
+
+                else if(glb::controller.get_digital(pros::E_CONTROLLER_DIGITAL_A))
+                {
+                    flywheel::target = 580;
+                }
+        
+                else if(glb::controller.get_digital(pros::E_CONTROLLER_DIGITAL_R1))
+                {
+                    flywheel::target = 470;
+                }
+
+                else if(glb::controller.get_digital(pros::E_CONTROLLER_DIGITAL_R2))
+                {
+                    flywheel::target = 400;
+                }
+
+                else
+                {
+                    flywheel::target = prevSpeed;
+                }
             }
 
-            else if(glb::controller.get_digital(pros::E_CONTROLLER_DIGITAL_R2))
-            {
-                flywheel::target = 450;
-            }
-            
             else
             {
-                flywheel::target = prevSpeed;
+                if(glb::controller.get_digital(pros::E_CONTROLLER_DIGITAL_L1))
+                {
+                    flywheel::target = 390;
+                }
+
+                else if(glb::controller.get_digital(pros::E_CONTROLLER_DIGITAL_R1))
+                {
+                    flywheel::target = 530;
+                }
+
+                else if(glb::controller.get_digital(pros::E_CONTROLLER_DIGITAL_R2))
+                {
+                    flywheel::target = 450;
+                }
+            
+                else
+                {
+                    flywheel::target = prevSpeed;
+                }
             }
         }
         decelTimer.start();
@@ -190,15 +222,9 @@ void felixControl()
         {
             indexTimer.start();
             fowrardTimer.start();
-            flywheel::ff = -1;
             // inRange.start();
         }
 
-        if(glb::controller.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_R1))
-        {
-            flywheel::ff = 3;
-        }
-
         // if(glb::controller.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_L1))
         // {
         //     robot::tsukasa.toggle();
@@ -233,7 +259,12 @@ void felixControl()
     {
         robot::angler.toggle();
 
-        if(robot::angler.state)
+        if(shot::tracking)
+        {
+            shot::autoAngler = false;
+        }
+
+        else if(robot::angler.state)
         {
             flywheel::target -= 40;
         }
@@ -289,22 +320,11 @@ void felixControl()
     // }
     
 
-    if (decelTimer.time() > 9000)
+    // shot::track holds the rpm while tracking, so it isnt wound down
+    if (decelTimer.time() > 9000 && !shot::tracking)
     {
-        if (flywheel::target > 300)
-        {
-            flywheel::target -= 0.5;
-        }
-
-        else if (flywheel::target != 0)
-        {
-            flywheel::target = 300;
-        }
-
-        else
-        {
-            flywheel::target = 0;
-        }
+        // single read-modify-write so a preset pressed on the same tick isnt lost
+        flywheel::target.update([](double t) { return t > 300 ? t - 0.5 : t != 0 ? 300 : 0; });
 
         // flywheel::target > 300 ? flywheel::target -= 0.5 : flywheel::target != 0 ? flywheel::target = 300 : flywheel::target = 0;
     }
@@ -361,39 +381,26 @@ void keejControl()
     if(glb::controller.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_RIGHT))
     {
         toggled = !toggled;
+        aim::recording = toggled;
     }
     
     if(glb::controller.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_LEFT))
     {
         glb::red = !glb::red;
+        shot::useAlliance();
     }
 
     if(std::abs(lStick) < 9 && std::abs(rStick) < 9 && decelTimer.time() <= 8000 && toggled)
     {
-        static util::pid pid(util::pidConstants(0.6, 0.1, 0, 0.1, 0.3, 1000), 1000);
-        pros::vision_object_s_t goal;
-        int center;
-        if(glb::red)
-        {
-            pros::vision_object_s_t goal = glb::vision.get_by_sig(0, 1);
-            center = 87;
-        }
-        else
+        static util::pid pid(aim::constants, 1000);
+        aim::signature = glb::red ? aim::redSig : aim::blueSig;
+        aim::target goal = aim::goal.read();
+
+        if(goal.visible)
         {
-            pros::vision_object_s_t goal = glb::vision.get_by_sig(0, 2);
-            center = 68;
+            int vel = pid.out(goal.error);
+            robot::chass.spinDiffy(-vel, vel);
         }
-
-        int x = goal.left_coord;
-        int error = center-x;
-        // if(std::abs(error) < 1)
-        // {
-        //     error = 0;
-        // }
-
-        int vel = pid.out(error);
-        
-        robot::chass.spinDiffy(-vel, vel);
     }
     // if(std::abs(lStick) < 10 && std::abs(rStick) < 10)
     // {
@@ -414,7 +421,12 @@ void keejControl()
         glb::controller.rumble(".");
         robot::angler.toggle();
 
-        if(robot::angler.state)
+        if(shot::tracking)
+        {
+            shot::autoAngler = false;
+        }
+
+        else if(robot::angler.state)
         {
             flywheel::target += 25;
         }
@@ -428,54 +440,71 @@ void keejControl()
     else if(glb::controller.get_digital(pros::E_CONTROLLER_DIGITAL_L2))
     {
         doubleTap.start();
-        if(!robot::angler.state)
-        {
-            if(glb::controller.get_digital(pros::E_CONTROLLER_DIGITAL_L1))
-            {
-                flywheel::target = 350;
-            }
-
-            else if(glb::controller.get_digital(pros::E_CONTROLLER_DIGITAL_RIGHT))
-            {
-                flywheel::target = 580;
-            }
-        
-            else if(glb::controller.get_digital(pros::E_CONTROLLER_DIGITAL_R1))
-            {
-                flywheel::target = 470;
-            }
 
-            else if(glb::controller.get_digital(pros::E_CONTROLLER_DIGITAL_R2))
-            {
-                flywheel::target = 400;
-            }
-
-            else
-            {
-                flywheel::target = prevSpeed;
-            }
+        // L2 + B hands the rpm to the shot table, L2 + a preset takes it back
+        if(glb::controller.get_digital(pros::E_CONTROLLER_DIGITAL_B))
+        {
+            shot::tracking = true;
+            shot::autoAngler = true;
         }
 
-        else
+        else if(presetHeld())
         {
-            if(glb::controller.get_digital(pros::E_CONTROLLER_DIGITAL_L1))
-            {
-                flywheel::target = 375;
-            }
-
-            else if(glb::controller.get_digital(pros::E_CONTROLLER_DIGITAL_R1))
-            {
-                flywheel::target = 530;
-            }
+            shot::tracking = false;
+            shot::autoAngler = false;
+        }
 
-            else if(glb::controller.get_digital(pros::E_CONTROLLER_DIGITAL_R2))
+        if(!shot::tracking)
+        {
+            if(!robot::angler.state)
             {
-                flywheel::target = 450;
+                if(glb::controller.get_digital(pros::E_CONTROLLER_DIGITAL_L1))
+                {
+                    flywheel::target = 350;
+                }
+
+                else if(glb::controller.get_digital(pros::E_CONTROLLER_DIGITAL_RIGHT))
+                {
+                    flywheel::target = 580;
+                }
+        
+                else if(glb::controller.get_digital(pros::E_CONTROLLER_DIGITAL_R1))
+                {
+                    flywheel::target = 470;
+                }
+
+                else if(glb::controller.get_digital(pros::E_CONTROLLER_DIGITAL_R2))
+                {
+                    flywheel::target = 400;
+                }
+
+                else
+                {
+                    flywheel::target = prevSpeed;
+                }
             }
 
             else
             {
-                flywheel::target = prevSpeed;
+                if(glb::controller.get_digital(pros::E_CONTROLLER_DIGITAL_L1))
+                {
+                    flywheel::target = 375;
+                }
+
+                else if(glb::controller.get_digital(pros::E_CONTROLLER_DIGITAL_R1))
+                {
+                    flywheel::target = 530;
+                }
+
+                else if(glb::controller.get_digital(pros::E_CONTROLLER_DIGITAL_R2))
+                {
+                    flywheel::target = 450;
+                }
+
+                else
+                {
+                    flywheel::target = prevSpeed;
+                }
             }
         }
 
@@ -514,15 +543,9 @@ void keejControl()
         {
             indexTimer.start();
             fowrardTimer.start();
-            flywheel::ff = -1;
             // inRange.start();
         }
 
-        if(glb::controller.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_L1))
-        {
-            flywheel::ff = 3;
-        }
-
         if(glb::controller.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_R2))
         {
             robot::tsukasa.toggle();
@@ -553,7 +576,7 @@ void keejControl()
     }
     
 
-    if(glb::controller.get_digital(pros::E_CONTROLLER_DIGITAL_B))
+    if(glb::controller.get_digital(pros::E_CONTROLLER_DIGITAL_B) && !glb::controller.get_digital(pros::E_CONTROLLER_DIGITAL_L2))
     {
         // double target = 180 - absoluteAngleToPoint(glb::pos, util::coordinate(0,0));
         // target = target >= 0 ? target : 180 + fabs(target); //conver to 0-360
@@ -566,22 +589,9 @@ void keejControl()
     }
     
 
-    if (decelTimer.time() > 9000)
+    if (decelTimer.time() > 9000 && !shot::tracking)
     {
-        if (flywheel::target > 300)
-        {
-            flywheel::target -= 0.5;
-        }
-
-        else if (flywheel::target != 0)
-        {
-            flywheel::target = 300;
-        }
-
-        else
-        {
-            flywheel::target = 0;
-        }
+        flywheel::target.update([](double t) { return t > 300 ? t - 0.5 : t != 0 ? 300 : 0; });
 
         // flywheel::target > 300 ? flywheel::target -= 0.5 : flywheel::target != 0 ? flywheel::target = 300 : flywheel::target = 0;
     }
@@ -606,7 +616,12 @@ void anthony()
     {
         robot::angler.toggle();
 
-        if(robot::angler.state)
+        if(shot::tracking)
+        {
+            shot::autoAngler = false;
+        }
+
+        else if(robot::angler.state)
         {
             flywheel::target += 40;
         }
@@ -733,15 +748,9 @@ void anthony()
         {
             indexTimer.start();
             fowrardTimer.start();
-            flywheel::ff = -1;
             // inRange.start();
         }
 
-        if(glb::controller.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_L1))
-        {
-            flywheel::ff = 3;
-        }
-
         if(glb::controller.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_R2))
         {
             robot::tsukasa.toggle();
@@ -774,7 +783,12 @@ void anthony()
     {
         robot::angler.toggle();
 
-        if(robot::angler.state)
+        if(shot::tracking)
+        {
+            shot::autoAngler = false;
+        }
+
+        else if(robot::angler.state)
         {
             flywheel::target += 40;
         }
@@ -830,22 +844,9 @@ void anthony()
     // }
     
 
-    if (decelTimer.time() > 6000)
+    if (decelTimer.time() > 6000 && !shot::tracking)
     {
-        if (flywheel::target > 300)
-        {
-            flywheel::target -= 0.5;
-        }
-
-        else if (flywheel::target != 0)
-        {
-            flywheel::target = 300;
-        }
-
-        else
-        {
-            flywheel::target = 0;
-        }
+        flywheel::target.update([](double t) { return t > 300 ? t - 0.5 : t != 0 ? 300 : 0; });
 
         // flywheel::target > 300 ? flywheel::target -= 0.5 : flywheel::target != 0 ? flywheel::target = 300 : flywheel::target = 0;
     }
@@ -956,6 +957,7 @@ void (*autonSelector())()
     }
 
     glb::red = color % 2 == 0 ? true : false;
+    shot::useAlliance();
 
     pros::delay(200);
 
@@ -1,5 +1,9 @@
 #include "global.hpp"
 #include "util.hpp"
+#include "telemetry.hpp"
+#include "profiler.hpp"
+
+const uint16_t odomLog = telemetry::define("odom", "x,y,heading");
 
 
 void odom()
@@ -18,8 +22,16 @@ void odom()
     double horizOffset = 0 * scaleFactor;
     double vertOffset = 0 * scaleFactor;
 
+    /* velocity is smoothed a little since the encoders only move a few ticks per loop. the loop is slower than the
+    10ms delay, so it is divided by the measured time between reads
+    */
+    double velSmoothing = 0.3;
+    util::coordinate vel(0, 0);
+    uint64_t prevTime = pros::micros();
+
     while(1)
     {
+        profiler::odom.begin();
         // glb::controller.print(1,1,"%f", glb::imu.get_heading());
 
         // calcualting change in rotation
@@ -42,6 +54,10 @@ void odom()
         deltaRotation = util::dtr(deltaRotation);
         currRotation = util::dtr(currRotation);
 
+        uint64_t now = pros::micros();
+        double dt = (now - prevTime) / 1e6;
+        prevTime = now;
+
         // change in encoder value
         double deltaVert = (trackingCirumfrence / 360) * glb::leftEncoder.get_value() * scaleFactor;
         double deltaHoriz = (trackingCirumfrence / 360) * glb::horizEncoder.get_value() * scaleFactor;
@@ -76,11 +92,20 @@ void odom()
         // glb::controller.print(0,0,"(%f, %f)\n", deltaX,deltaY);
         glb::pos.x -= deltaX;
         glb::pos.y += deltaY;
+        if (dt > 0)
+        {
+            vel.x += velSmoothing * (-deltaX / dt - vel.x);
+            vel.y += velSmoothing * (deltaY / dt - vel.y);
+            glb::vel.write(vel);
+        }
+
+        telemetry::record(odomLog, glb::pos.x, glb::pos.y, util::rtd(currRotation));
 
         // reset encoders
         glb::horizEncoder.reset();
         glb::leftEncoder.reset();
 
+        profiler::odom.end();
         pros::delay(10);
     }
 }
@@ -0,0 +1,215 @@
+#ifndef __PROFILER__
+#define __PROFILER__
+
+#include "main.h"
+#include "pros/rtos.hpp"
+#include "telemetry.hpp"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/* loop timing. wrap the work part of a loop in begin()/end() (or a scope for a whole function) and every second the
+report task writes each section to the telemetry log:
+    <name>.loop   min,mean,max    microseconds spent in the section
+    <name>.load   p99,busy,period p99 in microseconds, busy as a percent of wall time, worst gap between begins
+
+a section should only be timed from one task at a time. a scope also ends on a break or return, and idle() after the
+loop keeps the time until the next one out of period
+*/
+namespace profiler
+{
+    // log scale buckets, 4 per octave, so p99 is within a quarter of the real value. tops out around 130ms
+    const int buckets = 64;
+    const int reportPeriod = 1000;
+
+    int bucket(uint32_t us)
+    {
+        if (us < 4)
+        {
+            return us;
+        }
+
+        int msb = 31 - __builtin_clz(us);
+        int index = (msb - 1) * 4 + ((us >> (msb - 2)) & 3);
+        return index < buckets ? index : buckets - 1;
+    }
+
+    // largest time that lands in a bucket
+    uint32_t bucketTop(int index)
+    {
+        if (index < 4)
+        {
+            return index;
+        }
+
+        int shift = index / 4 - 1;
+        return ((4 + index % 4 + 1) << shift) - 1;
+    }
+
+    class section;
+    std::vector<section*> sections;
+
+    class section
+    {
+        public:
+            // written by the timed task
+            std::atomic<uint32_t> count{0};
+            std::atomic<uint32_t> total{0};
+            std::atomic<uint32_t> histogram[buckets];
+            std::atomic<uint32_t> minTime{UINT32_MAX};
+            std::atomic<uint32_t> maxTime{0};
+            std::atomic<uint32_t> maxPeriod{0};
+            uint32_t start = 0;
+            uint32_t lastStart = 0;
+
+            // last totals seen by the report task
+            uint32_t reportedCount = 0;
+            uint32_t reportedTotal = 0;
+            uint32_t reportedHistogram[buckets] = {};
+
+            uint16_t loopChannel;
+            uint16_t loadChannel;
+
+            section(const char * name)
+            {
+                std::string base = name;
+                loopChannel = telemetry::define((base + ".loop").c_str(), "min,mean,max");
+                loadChannel = telemetry::define((base + ".load").c_str(), "p99,busy,period");
+
+                for (int i = 0; i < buckets; i++)
+                {
+                    histogram[i].store(0);
+                }
+
+                sections.push_back(this);
+            }
+
+            void begin()
+            {
+                start = pros::micros();
+
+                if (lastStart != 0 && start - lastStart > maxPeriod.load(std::memory_order_relaxed))
+                {
+                    maxPeriod.store(start - lastStart, std::memory_order_relaxed);
+                }
+
+                lastStart = start;
+            }
+
+            void end()
+            {
+                add(pros::micros() - start);
+            }
+
+            // the timed loop has stopped, the gap until it starts again isnt counted as a period
+            void idle()
+            {
+                lastStart = 0;
+            }
+
+            // only the owning task writes, the report task swaps min/max out so a sample can be lost at the boundary
+            void add(uint32_t us)
+            {
+                count.fetch_add(1, std::memory_order_relaxed);
+                total.fetch_add(us, std::memory_order_relaxed);
+                histogram[bucket(us)].fetch_add(1, std::memory_order_relaxed);
+
+                if (us < minTime.load(std::memory_order_relaxed))
+                {
+                    minTime.store(us, std::memory_order_relaxed);
+                }
+
+                if (us > maxTime.load(std::memory_order_relaxed))
+                {
+                    maxTime.store(us, std::memory_order_relaxed);
+                }
+            }
+    };
+
+    class scope
+    {
+        private:
+            section & timed;
+
+        public:
+            scope(section & s) : timed(s)
+            {
+                timed.begin();
+            }
+
+            ~scope()
+            {
+                timed.end();
+            }
+    };
+
+    void report()
+    {
+        uint32_t lastReport = pros::micros();
+
+        while (true)
+        {
+            pros::delay(reportPeriod);
+
+            uint32_t now = pros::micros();
+            double window = now - lastReport;
+            lastReport = now;
+
+            for (section * s : sections)
+            {
+                uint32_t count = s->count.load(std::memory_order_relaxed);
+                uint32_t total = s->total.load(std::memory_order_relaxed);
+                uint32_t samples = count - s->reportedCount;
+                uint32_t time = total - s->reportedTotal;
+                uint32_t minTime = s->minTime.exchange(UINT32_MAX, std::memory_order_relaxed);
+                uint32_t maxTime = s->maxTime.exchange(0, std::memory_order_relaxed);
+                uint32_t maxPeriod = s->maxPeriod.exchange(0, std::memory_order_relaxed);
+
+                s->reportedCount = count;
+                s->reportedTotal = total;
+
+                // walk the window's histogram up to the 99th percentile
+                uint32_t p99 = 0;
+                uint32_t seen = 0;
+                uint32_t rank = samples - samples / 100;
+
+                for (int i = 0; i < buckets; i++)
+                {
+                    uint32_t current = s->histogram[i].load(std::memory_order_relaxed);
+                    uint32_t inWindow = current - s->reportedHistogram[i];
+                    s->reportedHistogram[i] = current;
+
+                    if (seen < rank && seen + inWindow >= rank)
+                    {
+                        p99 = bucketTop(i);
+                    }
+
+                    seen += inWindow;
+                }
+
+                // nothing ran this second, auton primitives are idle most of the match
+                if (samples == 0)
+                {
+                    continue;
+                }
+
+                telemetry::record(s->loopChannel, minTime, (double)time / samples, maxTime);
+                telemetry::record(s->loadChannel, p99 < maxTime ? p99 : maxTime, time / window * 100, maxPeriod);
+            }
+        }
+    }
+
+    void start()
+    {
+        pros::Task reporter(report, TASK_PRIORITY_MIN + 1, TASK_STACK_DEPTH_DEFAULT, "profiler");
+    }
+
+    // - sections for the main loops
+    section odom("odom");
+    section flywheel("flywheel");
+    section driver("driver");
+    section chassis("chassis");
+}
+
+#endif
@@ -0,0 +1,194 @@
+#ifndef __SCRIPT__
+#define __SCRIPT__
+
+#include "main.h"
+#include "autoaim.hpp"
+#include "bytecode.hpp"
+#include "chassis.hpp"
+#include "display.hpp"
+#include "flywheel.hpp"
+#include "global.hpp"
+#include "pros/rtos.hpp"
+#include "shot.hpp"
+#include "trace.hpp"
+#include "util.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+/* runs autons compiled by tools/autonc.py off the sd card, so a routine can change without a re-upload. the script
+format is documented there, the scripts live in v2/scripts and the compiled format is in bytecode.hpp
+*/
+namespace script
+{
+    const char * const path = "/usd/auton.aut";
+    const char * const brakes[] = {"c", "b", "h"};
+
+    // one span per step, a is the opcode and b where it is in the code
+    trace::event stepTrace("script", "step");
+
+    std::vector<uint8_t> code;
+
+    // parallel branches still running, stop() ends them
+    std::vector<pros::task_t> branchTasks;
+    pros::Mutex branchLock;
+
+    group::pis * pistonFor(int id)
+    {
+        group::pis * pistons[] = {&robot::tsukasa, &robot::cata, &robot::plane, &robot::angler};
+        return id >= 0 && id < 4 ? pistons[id] : nullptr;
+    }
+
+    util::pidConstants pid(const float * a)
+    {
+        return util::pidConstants(a[0], a[1], a[2], a[3], a[4], a[5]);
+    }
+
+    bool load(const char * file = path)
+    {
+        return(load(file, code));
+    }
+
+    void exec(const uint8_t * pc, const uint8_t * end);
+
+    /* every branch but the last gets its own task, the last runs on this one, returns once they've all finished. the
+    count is shared with the branches rather than on this stack, so a branch outliving an ended auton task is safe
+    */
+    const uint8_t * runParallel(const uint8_t * pc)
+    {
+        int branches = *pc++;
+        std::shared_ptr<std::atomic<int>> running = std::make_shared<std::atomic<int>>(branches - 1);
+
+        for (int i = 0; i < branches; i++)
+        {
+            uint32_t length;
+            memcpy(&length, pc, 4);
+            const uint8_t * body = pc + 4;
+            pc = body + length;
+
+            if (i < branches - 1)
+            {
+                // held until the handle is in the list, so a branch that finishes straight away can still find itself
+                branchLock.take(TIMEOUT_MAX);
+
+                pros::Task branch([body, length, running] {
+                    exec(body, body + length);
+
+                    branchLock.take(TIMEOUT_MAX);
+                    pros::task_t self = pros::c::task_get_current();
+                    branchTasks.erase(std::remove(branchTasks.begin(), branchTasks.end(), self), branchTasks.end());
+                    (*running)--;
+                    branchLock.give();
+                }, TASK_PRIORITY_DEFAULT, TASK_STACK_DEPTH_DEFAULT, "script");
+
+                branchTasks.push_back(branch);
+                branchLock.give();
+            }
+
+            else
+            {
+                exec(body, body + length);
+            }
+        }
+
+        while (*running > 0)
+        {
+            pros::delay(5);
+        }
+
+        return(pc);
+    }
+
+    /* ends every parallel branch an auton left running and forgets any task waiting on the flywheel. disabled() and
+    opcontrol() call it since competition control only ends the auton task itself
+    */
+    void stop()
+    {
+        flywheel::cancelWait();
+        branchLock.take(TIMEOUT_MAX);
+
+        for (pros::task_t task : branchTasks)
+        {
+            pros::c::task_delete(task);
+        }
+
+        branchTasks.clear();
+        branchLock.give();
+    }
+
+    void exec(const uint8_t * pc, const uint8_t * end)
+    {
+        float a[maxArgs];
+
+        while (pc < end)
+        {
+            const uint8_t * at = pc;
+            uint8_t o = *pc++;
+
+            memcpy(a, pc, argc[o] * 4);
+            pc += argc[o] * 4;
+
+            trace::span traced(stepTrace, o, at - code.data());
+
+            switch ((op)o)
+            {
+                case op::wait: pros::delay(a[0]); break;
+                case op::spinTo: chas::spinTo(a[0], a[1], pid(a + 2)); break;
+                case op::drive: chas::drive(a[0], a[1], a[2]); break;
+                case op::autoDrive: chas::autoDrive(a[0], a[1], a[2], pid(a + 3), pid(a + 9)); break;
+                case op::odomDrive: chas::odomDrive(a[0], a[1], a[2]); break;
+                case op::moveTo: chas::moveTo(util::coordinate(a[0], a[1]), a[2], pid(a + 3), pid(a + 9), a[15], a[16], a[17]); break;
+                case op::timedSpin: chas::timedSpin(a[0], a[1], a[2]); break;
+                case op::velsUntilHeading: chas::velsUntilHeading(a[0], a[1], a[2], a[3], a[4]); break;
+                case op::arcTurn: chas::arcTurn(a[0], a[1], a[2], pid(a + 3)); break;
+                case op::chassis: robot::chass.spinDiffy(a[0], a[1]); break;
+                case op::chassisStop: robot::chass.stop(brakes[(int)a[0]]); break;
+                // these wait for a volley or an index on another branch to finish rather than fight it for the intake
+                case op::intake: robot::intakeOwner.take(TIMEOUT_MAX); robot::intake.spin(a[0]); robot::intakeOwner.give(); break;
+                case op::intakeStop: robot::intakeOwner.take(TIMEOUT_MAX); robot::intake.stop(brakes[(int)a[0]]); robot::intakeOwner.give(); break;
+                case op::index: intake::index(a[0]); break;
+                case op::waitIndex: intake::waitIndex(a[0], a[1], a[2], a[3], a[4], a[5]); break;
+                case op::toggle: robot::intakeOwner.take(TIMEOUT_MAX); intake::toggle(a[0] != 0, a[1]); robot::intakeOwner.give(); break;
+                case op::flywheel: flywheel::target = a[0]; break;
+                case op::waitReady: flywheel::waitReady(a[0], a[1], a[2]); break;
+
+                case op::piston:
+                {
+                    group::pis * p = pistonFor(a[0]);
+
+                    if (p != nullptr)
+                    {
+                        a[1] == 2 ? p->toggle() : p->setState(a[1] != 0);
+                    }
+
+                    break;
+                }
+
+                case op::volley: shot::volley = a[0]; break;
+
+                case op::waitVolley: shot::waitVolley(a[0]); break;
+
+                case op::aim: autoAim(a[0], a[1]); break;
+                case op::parallel: pc = runParallel(pc); break;
+                case op::goal: shot::setGoal(util::coordinate(a[0], a[1])); break;
+            }
+        }
+    }
+
+    // the selector's sdAuton, uses what initialize() loaded and tries the card again if that was nothing
+    void fromCard()
+    {
+        if (code.empty() && !load())
+        {
+            display::print(0, "no %s", path + 5);
+            return;
+        }
+
+        exec(code.data(), code.data() + code.size());
+    }
+}
+
+#endif
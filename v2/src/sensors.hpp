@@ -0,0 +1,106 @@
+#ifndef __SENSORS__
+#define __SENSORS__
+
+#include "main.h"
+#include "pros/rtos.hpp"
+#include "util.hpp"
+#include <cstdint>
+#include <vector>
+
+/* every motor is read once per tick by sample() and published as one frame, the motor groups read from the latest
+frame instead of asking the motors. the motors only refresh their data every 10ms anyway, so this is the same data
+with a fraction of the device calls, and everything read in a tick comes from the same instant. sample() runs above
+the control tasks, so a frame is never half taken when one of them runs
+*/
+namespace sensors
+{
+    const int ports = 21;
+    const int period = 10;
+
+    // struct of arrays indexed by port - 1
+    struct frame
+    {
+        uint32_t time;              // millis when it was sampled
+        float position[ports];      // encoder units of the motor's gearset
+        float velocity[ports];      // rpm
+        float current[ports];       // mA
+        float temperature[ports];   // celsius
+        float voltage[ports];       // mV
+    };
+
+    std::vector<pros::Motor> motors;
+    util::snapshot<frame> latest;
+
+    // the groups add their motors when they're built, returns the index into the frame arrays
+    int add(const pros::Motor & motor)
+    {
+        for (int i = 0; i < motors.size(); i++)
+        {
+            if (motors[i].get_port() == motor.get_port())
+            {
+                return motor.get_port() - 1;
+            }
+        }
+
+        motors.push_back(motor);
+        return motor.get_port() - 1;
+    }
+
+    frame read()
+    {
+        return latest.read();
+    }
+
+    // - single fields of the latest frame, without copying the rest of it
+    float velocity(int slot)
+    {
+        return latest.read([slot](const frame & f) { return f.velocity[slot]; });
+    }
+
+    float current(int slot)
+    {
+        return latest.read([slot](const frame & f) { return f.current[slot]; });
+    }
+
+    float temperature(int slot)
+    {
+        return latest.read([slot](const frame & f) { return f.temperature[slot]; });
+    }
+
+    float voltage(int slot)
+    {
+        return latest.read([slot](const frame & f) { return f.voltage[slot]; });
+    }
+
+    void sample()
+    {
+        frame next = {};
+        uint32_t wake = pros::millis();
+
+        while (true)
+        {
+            next.time = pros::millis();
+
+            for (int i = 0; i < motors.size(); i++)
+            {
+                int slot = motors[i].get_port() - 1;
+                next.position[slot] = motors[i].get_position();
+                next.velocity[slot] = motors[i].get_actual_velocity();
+                next.current[slot] = motors[i].get_current_draw();
+                next.temperature[slot] = motors[i].get_temperature();
+                next.voltage[slot] = motors[i].get_voltage();
+            }
+
+            latest.write(next);
+            pros::Task::delay_until(&wake, period);
+        }
+    }
+
+    // before the control tasks so their first reads aren't empty
+    void start()
+    {
+        pros::Task sampler(sample, TASK_PRIORITY_DEFAULT + 1, TASK_STACK_DEPTH_DEFAULT, "sensors");
+    }
+}
+
+#endif
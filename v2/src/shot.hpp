@@ -0,0 +1,328 @@
+#ifndef __SHOT__
+#define __SHOT__
+
+#include "global.hpp"
+#include "chassis.hpp"
+#include "display.hpp"
+#include "flywheel.hpp"
+#include "autoaim.hpp"
+#include "util.hpp"
+#include <atomic>
+#include <cmath>
+#include <vector>
+
+namespace shot
+{
+    /* goal positions in the odom frame for driver control, from where the robot starts driver skills. odom starts
+    wherever the robot was when it started, so an auton that shoots on the move calls setGoal() with the goal relative
+    to its own start
+    */
+    util::coordinate redGoal(-120, 120);
+    util::coordinate blueGoal(120, -120);
+
+    // the goal to shoot at, written by useAlliance() and setGoal() and read by the shot tasks
+    util::snapshot<util::coordinate> goalPos;
+
+    // when set, track() keeps flywheel::target on the table value for the current distance
+    std::atomic<bool> tracking(false);
+
+    // when set, track() also picks the angler, up inside anglerRange and down past it
+    std::atomic<bool> autoAngler(false);
+
+    // what track() picked, applyAngler() moves the piston from the driver loop so only one task ever touches it
+    std::atomic<bool> anglerWanted(false);
+    const double anglerRange = 60;
+    const double anglerHysteresis = 6;
+
+    // odometry drifts so it isnt trusted to better than this, odom units
+    const double odomDeviation = 6;
+
+    struct row
+    {
+        double distance, rpm, anglerRpm;
+    };
+
+    /* distance to goal in odom units -> rpm with the angler down and up. sorted by distance, interpolated between rows
+    and clamped at both ends. the ends line up with the old driver presets
+    */
+    std::vector<row> table
+    {
+        {24, 350, 375},
+        {48, 400, 450},
+        {84, 470, 530},
+        {120, 580, 580},
+    };
+
+    // the driver default for the alliance colour, the selector and the driver's colour switch call it
+    void useAlliance()
+    {
+        goalPos.write(glb::red ? redGoal : blueGoal);
+    }
+
+    void setGoal(util::coordinate goal)
+    {
+        goalPos.write(goal);
+    }
+
+    util::coordinate goal()
+    {
+        return goalPos.read();
+    }
+
+    double distance()
+    {
+        return util::distToPoint(glb::pos, goal());
+    }
+
+    /* inverse variance blend of odometry and the vision range. vision is weighted down by the tracker confidence and
+    dropped when the goal isnt visible or its signature hasnt been calibrated
+    */
+    double fusedDistance()
+    {
+        double odom = distance();
+        aim::target goal = aim::goal.read();
+        double vision = aim::range(goal.width, goal.height, aim::signature);
+
+        if (!goal.visible || vision < 0 || goal.confidence <= 0)
+        {
+            return odom;
+        }
+
+        double visionVar = pow(aim::rangeDeviation(vision, aim::signature), 2) / goal.confidence;
+        double odomVar = odomDeviation * odomDeviation;
+
+        return (odom * visionVar + vision * odomVar) / (odomVar + visionVar);
+    }
+
+    // how far from the goal to park for calibrateRange(), odom units
+    const double calibrationDistance = 48;
+
+    /* the rangeCal selector entry. park calibrationDistance from the goal and facing it, then run it: it averages the
+    blob size for a second, works out the k that makes the vision range read that distance and saves it to the sd card
+    so it is loaded from then on
+    */
+    void calibrateRange()
+    {
+        aim::signature = glb::red ? aim::redSig : aim::blueSig;
+        util::timer timer;
+        double total = 0;
+        int frames = 0;
+
+        while (timer.time() < 1000)
+        {
+            aim::target goal = aim::goal.read();
+
+            if (goal.visible)
+            {
+                total += (goal.width + goal.height) / 2;
+                frames++;
+            }
+
+            pros::delay(aim::period);
+        }
+
+        if (frames == 0)
+        {
+            display::print(0, "no goal");
+            return;
+        }
+
+        int sig = aim::signature;
+        double k = calibrationDistance * total / frames;
+        aim::rangeKs[sig] = k;
+
+        if (!aim::saveRange())
+        {
+            display::print(0, "k %d: %.0f not saved", sig, k);
+            return;
+        }
+
+        display::print(0, "k %d: %.0f", sig, k);
+    }
+
+    double rpm(double distance, bool angler)
+    {
+        if (distance <= table.front().distance)
+        {
+            return angler ? table.front().anglerRpm : table.front().rpm;
+        }
+
+        for (int i = 1; i < table.size(); i++)
+        {
+            if (distance <= table[i].distance)
+            {
+                row lo = table[i-1];
+                row hi = table[i];
+                double t = (distance - lo.distance) / (hi.distance - lo.distance);
+
+                return angler ? lo.anglerRpm + (hi.anglerRpm - lo.anglerRpm) * t : lo.rpm + (hi.rpm - lo.rpm) * t;
+            }
+        }
+
+        return angler ? table.back().anglerRpm : table.back().rpm;
+    }
+
+    // - shooting on the move
+    // disc speed out of the flywheel per rpm, odom units per second
+    const double launchRatio = 0.45;
+
+    // from the intake pushing a disc to it leaving the flywheel, seconds
+    const double launchDelay = 0.12;
+
+    struct solution
+    {
+        util::coordinate aimPoint;
+        double heading;         // imu heading to face
+        double distance;        // static shot distance that lands the same
+        double rpm;
+        double tof;             // seconds
+        double impactError;     // how far the disc would miss with the current heading, odom units
+    };
+
+    /* where to aim so the disc lands while the robot keeps moving. the disc keeps the robot's velocity so the aim point
+    is the goal moved back along that velocity for the flight time, which itself depends on the distance to that point
+    so it is iterated a few times
+    */
+    solution solve()
+    {
+        util::coordinate target = goal();
+        util::coordinate aimPoint = target;
+        util::coordinate velocity = glb::vel.read();
+        double dist = distance();
+        double speed = rpm(dist, robot::angler.state);
+        double tof = 0;
+
+        for (int i = 0; i < 3; i++)
+        {
+            tof = launchDelay + dist / (speed * launchRatio);
+            aimPoint = util::coordinate(target.x - velocity.x * tof, target.y - velocity.y * tof);
+            dist = util::distToPoint(glb::pos, aimPoint);
+            speed = rpm(dist, robot::angler.state);
+        }
+
+        double heading = util::absoluteAngleToPoint(glb::pos, aimPoint);
+        double headingError = util::minError(heading, robot::imu.degHeading());
+
+        return solution{aimPoint, heading, dist, speed, tof, dist * sin(util::dtr(std::min(headingError, 90.0)))};
+    }
+
+    // discs left to fire on the move, an auton sets it and carries on driving
+    std::atomic<int> volley(0);
+    double impactTolerance = 4;
+    double rpmTolerance = 15;
+
+    /* background task. while there is a volley queued it keeps the flywheel on the moving solution, steers autoDrive
+    onto the aim point through chas::aimHeading, and pushes a disc whenever the predicted miss and the flywheel error
+    are both inside tolerance. it holds robot::intakeOwner until the volley is done so nothing else drives the intake
+    under it
+    */
+    void fire()
+    {
+        bool owner = false;
+
+        while (true)
+        {
+            if (volley > 0)
+            {
+                solution s = solve();
+                flywheel::target = s.rpm;
+                chas::aimHeading = s.heading;
+
+                // an index already running finishes first
+                if (!owner)
+                {
+                    owner = robot::intakeOwner.take(0);
+                }
+
+                if (owner && s.impactError < impactTolerance && std::abs(flywheel::status.read().error) < rpmTolerance)
+                {
+                    robot::intake.spin(-80);
+                    pros::delay(200);
+                    robot::intake.stop("b");
+                    volley--;
+                    pros::delay(150);
+                    continue;
+                }
+            }
+
+            else
+            {
+                chas::aimHeading = NAN;
+
+                if (owner)
+                {
+                    robot::intakeOwner.give();
+                    owner = false;
+                }
+            }
+
+            pros::delay(10);
+        }
+    }
+
+    // spinTo's default gains without the integral, the aim point keeps moving so there is nothing to settle on
+    const double turnKp = 3.7;
+    const double turnKd = 26;
+
+    /* waits up to timeout ms for the volley to finish. nothing else is driving meanwhile, so it turns in place onto the
+    aim point to let fire() line the shots up
+    */
+    void waitVolley(int timeout)
+    {
+        util::timer timer;
+        double prevError = util::minError(solve().heading, robot::imu.degHeading());
+
+        while (volley > 0 && timer.time() < timeout)
+        {
+            double heading = solve().heading;
+            double currHeading = robot::imu.degHeading();
+            double error = util::minError(heading, currHeading);
+            int dir = -util::dirToSpin(heading, currHeading);
+            double vel = dir * (error * turnKp + (error - prevError) * turnKd);
+
+            prevError = error;
+            robot::chass.spinDiffy(vel, -vel);
+            pros::delay(10);
+        }
+
+        robot::chass.stop("b");
+    }
+
+    // called from opcontrol() after the driver controls
+    void applyAngler()
+    {
+        if (autoAngler && tracking && robot::angler.state != anglerWanted)
+        {
+            robot::angler.setState(anglerWanted);
+        }
+    }
+
+    // background task, follows the robot around so the wheel is already at speed when it stops
+    void track()
+    {
+        while (true)
+        {
+            // a volley on the move sets its own rpm
+            if (tracking && volley == 0)
+            {
+                double range = fusedDistance();
+
+                if (!autoAngler)
+                {
+                    anglerWanted = robot::angler.state;
+                }
+
+                else if (std::abs(range - anglerRange) > anglerHysteresis)
+                {
+                    anglerWanted = range < anglerRange;
+                }
+
+                flywheel::target = rpm(range, robot::angler.state);
+            }
+
+            pros::delay(20);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,150 @@
+#ifndef __STREAM__
+#define __STREAM__
+
+#include "main.h"
+#include "telemetry.hpp"
+#include "util.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+/* telemetry over the usb serial port, so tuning doesn't need an sd card or copying printf output. the telemetry flush
+task hands every batch to forward(), which frames the entries and writes them to stdout. tools/plot.py reads it.
+
+cobs is turned off so frames go out as raw bytes, printf output still comes through in between and the host skips it.
+the pros terminal can't read that, so initialize() only starts the stream when built with -DSERIAL_TELEMETRY.
+
+frame: 0xaa 0x55, type, payload length, payload, crc16 (ccitt, little endian) over type, length and payload
+    type 1, channel:  uint16 id then "name field,field,field" text
+    type 2, entry:    telemetry::entry as is (uint32 micros, uint16 channel, uint16 aux, 3 floats)
+channel frames are repeated every couple of seconds so the host can start listening at any time
+*/
+namespace stream
+{
+    const uint8_t syncA = 0xaa;
+    const uint8_t syncB = 0x55;
+    const uint8_t channelFrame = 1;
+    const uint8_t entryFrame = 2;
+    const int describePeriod = 2000;
+
+    // minimum micros between entries per channel, 0 sends every entry
+    std::vector<uint32_t> interval;
+    std::vector<uint32_t> lastSent;
+
+    uint8_t buffer[512];
+    int used = 0;
+    util::timer describeTimer;
+    bool described = false;
+
+    uint16_t crc16(const uint8_t * data, int length, uint16_t crc = 0xffff)
+    {
+        for (int i = 0; i < length; i++)
+        {
+            crc ^= data[i] << 8;
+
+            for (int j = 0; j < 8; j++)
+            {
+                crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+            }
+        }
+
+        return crc;
+    }
+
+    void send()
+    {
+        if (used > 0)
+        {
+            fwrite(buffer, 1, used, stdout);
+            fflush(stdout);
+            used = 0;
+        }
+    }
+
+    void frame(uint8_t type, const void * payload, uint8_t length)
+    {
+        if (used + length + 6 > sizeof(buffer))
+        {
+            send();
+        }
+
+        uint8_t * out = buffer + used;
+        out[0] = syncA;
+        out[1] = syncB;
+        out[2] = type;
+        out[3] = length;
+        memcpy(out + 4, payload, length);
+
+        uint16_t crc = crc16(out + 2, length + 2);
+        out[length + 4] = crc & 0xff;
+        out[length + 5] = crc >> 8;
+        used += length + 6;
+    }
+
+    void describe()
+    {
+        for (uint16_t i = 0; i < telemetry::channels.size(); i++)
+        {
+            uint8_t payload[255];
+            int length = snprintf((char *)payload + 2, sizeof(payload) - 2, "%s %s", telemetry::channels[i].name.c_str(),
+                telemetry::channels[i].fields.c_str());
+
+            memcpy(payload, &i, 2);
+            frame(channelFrame, payload, 2 + (length < sizeof(payload) - 2 ? length : sizeof(payload) - 3));
+        }
+    }
+
+    void forward(const telemetry::entry * batch, int count)
+    {
+        if (!described || describeTimer.time() >= describePeriod)
+        {
+            describe();
+            described = true;
+            describeTimer.start();
+        }
+
+        for (int i = 0; i < count; i++)
+        {
+            const telemetry::entry & e = batch[i];
+
+            if (e.channel < interval.size() && interval[e.channel] != 0)
+            {
+                if (e.time - lastSent[e.channel] < interval[e.channel])
+                {
+                    continue;
+                }
+
+                lastSent[e.channel] = e.time;
+            }
+
+            frame(entryFrame, &e, sizeof(e));
+        }
+
+        send();
+    }
+
+    // limit a channel to hz entries a second, channels can only be looked up once their header has defined them
+    void rate(const char * name, double hz)
+    {
+        interval.resize(telemetry::channels.size(), 0);
+        lastSent.resize(telemetry::channels.size(), 0);
+
+        for (int i = 0; i < telemetry::channels.size(); i++)
+        {
+            if (telemetry::channels[i].name == name)
+            {
+                interval[i] = hz > 0 ? 1e6 / hz : 0;
+            }
+        }
+    }
+
+    // call before telemetry::start()
+    void start()
+    {
+        pros::c::serctl(SERCTL_DISABLE_COBS, NULL);
+        telemetry::forward = forward;
+    }
+}
+
+#endif
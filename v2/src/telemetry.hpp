@@ -0,0 +1,207 @@
+#ifndef __TELEMETRY__
+#define __TELEMETRY__
+
+#include "main.h"
+#include "pros/rtos.hpp"
+#include "util.hpp"
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/* binary logging to the sd card. any task can record() a fixed size entry into a lock free ring buffer in well under a
+microsecond, a low priority task drains it to /usd/tlmN.bin. tools/tlmdecode.py turns the file back into csv.
+
+file layout: "TLM1\n", one "channel <id> <name> <field>,<field>,<field>\n" line per channel, "end\n", then packed
+entries
+*/
+namespace telemetry
+{
+    struct entry
+    {
+        uint32_t time;      // micros
+        uint16_t channel;
+        uint16_t aux;
+        float values[3];
+    };
+
+    struct channelInfo
+    {
+        std::string name;
+        std::string fields;
+    };
+
+    // channels have to be defined before start(), the headers do it at namespace scope
+    std::vector<channelInfo> channels;
+
+    uint16_t define(const char* name, const char* fields)
+    {
+        channels.push_back(channelInfo{name, fields});
+        return channels.size() - 1;
+    }
+
+    // - ring buffer, bounded multi producer queue with a sequence number per slot
+    const uint32_t capacity = 1024;
+
+    struct slot
+    {
+        std::atomic<uint32_t> sequence;
+        entry data;
+    };
+
+    slot ring[capacity];
+    std::atomic<uint32_t> head(0);
+    uint32_t tail = 0;
+    std::atomic<uint32_t> dropped(0);
+    std::atomic<bool> running(false);
+
+    void record(uint16_t channel, float a, float b = 0, float c = 0, uint16_t aux = 0)
+    {
+        if (!running)
+        {
+            return;
+        }
+
+        uint32_t pos = head.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            slot & s = ring[pos % capacity];
+            int32_t diff = (int32_t)(s.sequence.load(std::memory_order_acquire) - pos);
+
+            if (diff == 0)
+            {
+                if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    s.data = entry{(uint32_t)pros::micros(), channel, aux, {a, b, c}};
+                    s.sequence.store(pos + 1, std::memory_order_release);
+                    return;
+                }
+            }
+
+            // full, the flush task is behind
+            else if (diff < 0)
+            {
+                dropped++;
+                return;
+            }
+
+            else
+            {
+                pos = head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // single consumer
+    bool pop(entry & out)
+    {
+        slot & s = ring[tail % capacity];
+
+        if (s.sequence.load(std::memory_order_acquire) != tail + 1)
+        {
+            return false;
+        }
+
+        out = s.data;
+        s.sequence.store(tail + capacity, std::memory_order_release);
+        tail++;
+        return true;
+    }
+
+    FILE* open()
+    {
+        char path[32];
+
+        for (int i = 0; i < 100; i++)
+        {
+            snprintf(path, sizeof(path), "/usd/tlm%d.bin", i);
+            FILE* existing = fopen(path, "r");
+
+            if (existing == NULL)
+            {
+                return fopen(path, "wb");
+            }
+
+            fclose(existing);
+        }
+
+        return NULL;
+    }
+
+    // second consumer, stream.hpp sets it to send every batch over serial as well. called with count 0 when idle
+    void (*forward)(const entry * batch, int count) = NULL;
+
+    void flush()
+    {
+        FILE* file = open();
+
+        // no sd card is fine as long as something else wants the entries
+        if (file == NULL && forward == NULL)
+        {
+            running = false;
+            return;
+        }
+
+        if (file != NULL)
+        {
+            fprintf(file, "TLM1\n");
+
+            for (int i = 0; i < channels.size(); i++)
+            {
+                fprintf(file, "channel %d %s %s\n", i, channels[i].name.c_str(), channels[i].fields.c_str());
+            }
+
+            fprintf(file, "end\n");
+        }
+
+        entry batch[64];
+        util::timer flushTimer;
+
+        while (true)
+        {
+            int count = 0;
+
+            while (count < 64 && pop(batch[count]))
+            {
+                count++;
+            }
+
+            if (count > 0 && file != NULL)
+            {
+                fwrite(batch, sizeof(entry), count, file);
+            }
+
+            if (forward != NULL)
+            {
+                forward(batch, count);
+            }
+
+            if (file != NULL && flushTimer.time() >= 1000)
+            {
+                fflush(file);
+                flushTimer.start();
+            }
+
+            // keep going while there is a backlog, otherwise let the control tasks have the cpu
+            if (count < 64)
+            {
+                pros::delay(20);
+            }
+        }
+    }
+
+    void start()
+    {
+        for (uint32_t i = 0; i < capacity; i++)
+        {
+            ring[i].sequence.store(i);
+        }
+
+        running = true;
+        pros::Task flusher(flush, TASK_PRIORITY_MIN + 1, TASK_STACK_DEPTH_DEFAULT, "telemetry");
+    }
+}
+
+#endif
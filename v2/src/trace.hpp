@@ -0,0 +1,55 @@
+#ifndef __TRACE__
+#define __TRACE__
+
+#include "main.h"
+#include "telemetry.hpp"
+#include <string>
+
+/* begin/end events for the auton timeline. each event is its own telemetry channel named trace.<lane>.<name> with
+fields phase,a,b (phase 1 begin, 0 end, a and b are whatever the caller wants to see, usually the target).
+tools/trace.py turns a log into chrome trace json, one row per lane
+*/
+namespace trace
+{
+    class event
+    {
+        public:
+            uint16_t channel;
+
+            // has to be defined at namespace scope like any other channel
+            event(const char * lane, const char * name)
+            {
+                channel = telemetry::define(("trace." + std::string(lane) + "." + name).c_str(), "phase,a,b");
+            }
+
+            void begin(float a = 0, float b = 0)
+            {
+                telemetry::record(channel, 1, a, b);
+            }
+
+            void end(float a = 0, float b = 0)
+            {
+                telemetry::record(channel, 0, a, b);
+            }
+    };
+
+    // ends the event however the scope exits, motion functions break and return from all over
+    class span
+    {
+        private:
+            event & traced;
+
+        public:
+            span(event & e, float a = 0, float b = 0) : traced(e)
+            {
+                traced.begin(a, b);
+            }
+
+            ~span()
+            {
+                traced.end();
+            }
+    };
+}
+
+#endif
@@ -0,0 +1,205 @@
+#ifndef __TRACKER__
+#define __TRACKER__
+
+#include "main.h"
+#include "util.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+// goal tracking maths, kept apart from the devices so tools/aimreplay.cpp can run it on a computer
+namespace aim
+{
+    // signature ids set in initialize()
+    const int redSig = 1;
+    const int blueSig = 2;
+
+    // left_coord of the goal when the shot lines up, the vision sensor isnt mounted on the center of the robot
+    int center(int sig)
+    {
+        return sig == redSig ? 87 : 68;
+    }
+
+    util::pidConstants constants(0.6, 0.1, 0, 0.1, 0.3, 1000);
+
+    /* the goal's apparent size falls off as 1/distance so distance = k / size, with size the mean of the blob's width
+    and height. k is per signature since the two colours dont threshold to the same blob size. the rangeCal auton
+    measures it and saves it to rangePath, loadRange() reads it back at startup. 0 is uncalibrated, and there is no
+    vision range for that signature
+    */
+    util::atomicDouble rangeKs[3];
+    const char* rangePath = "/usd/range.cfg";
+
+    double rangeK(int sig)
+    {
+        return sig == redSig || sig == blueSig ? (double)rangeKs[sig] : 0.0;
+    }
+
+    // one "signature k" pair per line, anything else is ignored
+    bool loadRange(const char* path = rangePath)
+    {
+        FILE* file = fopen(path, "r");
+
+        if (file == NULL)
+        {
+            return false;
+        }
+
+        int sig;
+        double k;
+
+        while (fscanf(file, " %d %lf", &sig, &k) == 2)
+        {
+            if ((sig == redSig || sig == blueSig) && std::isfinite(k) && k > 0)
+            {
+                rangeKs[sig] = k;
+            }
+        }
+
+        fclose(file);
+        return true;
+    }
+
+    // writes both signatures' k, so calibrating one colour keeps the other
+    bool saveRange(const char* path = rangePath)
+    {
+        FILE* file = fopen(path, "w");
+
+        if (file == NULL)
+        {
+            return false;
+        }
+
+        fprintf(file, "%d %f\n%d %f\n", redSig, (double)rangeKs[redSig], blueSig, (double)rangeKs[blueSig]);
+        fclose(file);
+        return true;
+    }
+
+    // size in pixels below which the blob is too small to range off
+    const double minRangeSize = 4;
+
+    // odom units, -1 when there is no range
+    double range(double width, double height, int sig)
+    {
+        double size = (width + height) / 2;
+        return size < minRangeSize || rangeK(sig) <= 0 ? -1 : rangeK(sig) / size;
+    }
+
+    /* one pixel of size error is worth distance^2 / k of range error, which is the standard deviation used when fusing
+    with odometry
+    */
+    double rangeDeviation(double distance, int sig)
+    {
+        return distance * distance / rangeK(sig);
+    }
+
+    const int maxObjects = 8;
+    const int period = 20;
+
+    // alpha beta filter gains on the goal position and size
+    const double alpha = 0.5;
+    const double beta = 0.1;
+    const double sizeAlpha = 0.3;
+
+    // blobs further than this from the prediction are scored down, in pixels
+    const double gate = 40;
+
+    // frames the goal can go missing before it counts as lost
+    const int lostFrames = 10;
+
+    struct target
+    {
+        double x;           // filtered left_coord
+        double velocity;    // pixels per frame
+        double width;
+        double height;
+        double error;       // center - x
+        double confidence;  // 0 - 1
+        bool visible;
+        int time;           // millis when the frame was read
+        int latency;        // micros spent reading the frame
+    };
+
+    class tracker
+    {
+        private:
+            int missed = lostFrames;
+
+        public:
+            target state{};
+
+            // feeds one frame of blobs in, bigger blobs near the prediction win
+            target update(const pros::vision_object_s_t* objects, int count, int sig)
+            {
+                double predicted = state.x + state.velocity;
+                int best = -1;
+                double bestScore = 0;
+
+                for (int i = 0; i < count && i < maxObjects; i++)
+                {
+                    if (objects[i].signature != sig)
+                    {
+                        continue;
+                    }
+
+                    double score = objects[i].width * objects[i].height;
+
+                    if (state.visible)
+                    {
+                        score /= 1 + std::abs(objects[i].left_coord - predicted) / gate;
+                    }
+
+                    if (score > bestScore)
+                    {
+                        best = i;
+                        bestScore = score;
+                    }
+                }
+
+                if (best >= 0)
+                {
+                    const pros::vision_object_s_t & blob = objects[best];
+
+                    if (!state.visible)
+                    {
+                        state.x = blob.left_coord;
+                        state.velocity = 0;
+                        state.width = blob.width;
+                        state.height = blob.height;
+                    }
+
+                    else
+                    {
+                        double residual = blob.left_coord - predicted;
+                        state.x = predicted + alpha * residual;
+                        state.velocity += beta * residual;
+                        state.width += sizeAlpha * (blob.width - state.width);
+                        state.height += sizeAlpha * (blob.height - state.height);
+                    }
+
+                    missed = 0;
+                    state.confidence = std::min(1.0, state.confidence + 0.2);
+                }
+
+                else
+                {
+                    state.x = predicted;
+                    missed++;
+                    state.confidence = std::max(0.0, state.confidence - 0.1);
+                }
+
+                state.visible = missed < lostFrames;
+                state.error = center(sig) - state.x;
+
+                if (!state.visible)
+                {
+                    state.velocity = 0;
+                    state.confidence = 0;
+                }
+
+                return state;
+            }
+    };
+}
+
+#endif
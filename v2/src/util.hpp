@@ -2,7 +2,9 @@
 #define __UTIL__
 
 #include "main.h"
+#include <atomic>
 #include <cmath>
+#include <functional>
 #include <vector>
 
 #define PI 3.14159265358979323846
@@ -16,6 +18,10 @@ namespace util
     class pidConstants;
     class pid;
     class movingAverage;
+    class kalman;
+    class atomicDouble;
+    template <typename T> class snapshot;
+    class owner;
     double dtr(double input);
     double rtd(double input);
     int dirToSpin(double target,double currHeading);
@@ -65,7 +71,7 @@ class util::coordinate
             y = py;
         }
 
-        coordinate();
+        coordinate() : x(0), y(0) {}
 };
 
 class util::pose
@@ -188,7 +194,7 @@ class util::pid
 
     public:
 
-        pid(util::pidConstants cons, double error) : constants(cons), prevError(error){}
+        pid(util::pidConstants cons, double error) : prevError(error), constants(cons){}
 
         double out(double error)
         {
@@ -211,6 +217,14 @@ class util::pid
         {
             constants = cons;
         }
+
+        /* integralThreshold is left unset on the robot and the autons are tuned with it that way. tools/aimreplay
+        calls this so its runs are repeatable
+        */
+        void pinIntegralThreshold()
+        {
+            integralThreshold = constants.integralThreshold;
+        }
 };
 
 class util::movingAverage
@@ -265,6 +279,209 @@ class util::movingAverage
         }
 };
 
+/* two state kalman filter for a motor driven flywheel. the state is the wheel velocity and a disturbance
+acceleration (friction, discs being launched), the prediction step uses a first order motor model driven by
+the voltage sent last tick so the estimate doesnt lag behind the way a moving average does. every motor
+reading is fused in as its own measurement
+*/
+class util::kalman
+{
+    private:
+        double gain;
+        double tau;
+        double qVel;
+        double qDist;
+        double r;
+        double dt;
+
+        // state
+        double vel = 0;
+        double dist = 0;
+        double input = 0;
+
+        // covariance
+        double p00 = 10000;
+        double p01 = 0;
+        double p11 = 10000;
+
+    public:
+        kalman(double motorGain, double timeConstant, double velNoise, double distNoise, double sensorNoise, double period = 0.01) : gain(motorGain), tau(timeConstant), qVel(velNoise), qDist(distNoise), r(sensorNoise), dt(period) {}
+
+        void predict(double voltage)
+        {
+            input = voltage;
+            double a = 1 - dt/tau;
+
+            vel = a * vel + dt * dist + (dt * gain / tau) * voltage;
+
+            double n00 = a*a*p00 + 2*a*dt*p01 + dt*dt*p11 + qVel;
+            double n01 = a*p01 + dt*p11;
+            p11 = p11 + qDist;
+            p00 = n00;
+            p01 = n01;
+        }
+
+        void correct(double measurement)
+        {
+            double s = p00 + r;
+            double k0 = p00 / s;
+            double k1 = p01 / s;
+            double innovation = measurement - vel;
+
+            vel += k0 * innovation;
+            dist += k1 * innovation;
+
+            p11 -= k1 * p01;
+            p01 -= k0 * p01;
+            p00 -= k0 * p00;
+        }
+
+        double velocity()
+        {
+            return(vel);
+        }
+
+        // rpm per second
+        double acceleration()
+        {
+            return((gain * input - vel) / tau + dist);
+        }
+};
+
+/* a double that can be shared between tasks. assignments and += / -= never lose another task's write, update() does
+a read-modify-write the same way for anything more complicated
+*/
+class util::atomicDouble
+{
+    private:
+        std::atomic<double> value;
+
+    public:
+        atomicDouble(double v = 0) : value(v) {}
+
+        double update(std::function<double(double)> func)
+        {
+            double old = value.load();
+            double next = func(old);
+
+            while (!value.compare_exchange_weak(old, next))
+            {
+                next = func(old);
+            }
+
+            return(next);
+        }
+
+        double operator=(double v)
+        {
+            value.store(v);
+            return(v);
+        }
+
+        double operator+=(double delta)
+        {
+            return(update([delta](double v) { return v + delta; }));
+        }
+
+        double operator-=(double delta)
+        {
+            return(update([delta](double v) { return v - delta; }));
+        }
+
+        operator double() const
+        {
+            return(value.load());
+        }
+};
+
+/* publishes a struct from one task to any number of readers without a mutex. the writer fills the buffer that isnt
+published and then flips to it, a reader retries if a write finished while it was copying. the writer never waits
+so a high priority reader cant starve it
+*/
+template <typename T>
+class util::snapshot
+{
+    private:
+        T buffers[2];
+        std::atomic<unsigned> sequence{0};
+
+    public:
+        // single writer only
+        void write(const T & value)
+        {
+            unsigned s = sequence.load(std::memory_order_relaxed);
+            buffers[(s + 1) & 1] = value;
+            sequence.store(s + 1, std::memory_order_release);
+        }
+
+        T read()
+        {
+            T copy;
+            unsigned s;
+
+            do
+            {
+                s = sequence.load(std::memory_order_acquire);
+                copy = buffers[s & 1];
+                std::atomic_thread_fence(std::memory_order_acquire);
+            } while (sequence.load(std::memory_order_relaxed) != s);
+
+            return(copy);
+        }
+
+        // copies out only what pick returns from the published value, for when T is large and one field is needed
+        template <typename Pick>
+        auto read(Pick pick) -> decltype(pick(buffers[0]))
+        {
+            decltype(pick(buffers[0])) copy;
+            unsigned s;
+
+            do
+            {
+                s = sequence.load(std::memory_order_acquire);
+                copy = pick(buffers[s & 1]);
+                std::atomic_thread_fence(std::memory_order_acquire);
+            } while (sequence.load(std::memory_order_relaxed) != s);
+
+            return(copy);
+        }
+};
+
+/* one task at a time, like a mutex, but not tied to the task that took it. give() from anywhere releases it, so a
+task that was deleted while holding it (an auton ended by competition control) doesnt leave it held for good
+*/
+class util::owner
+{
+    private:
+        std::atomic<bool> held{false};
+
+    public:
+        // waits up to timeout ms, 0 only tries once
+        bool take(uint32_t timeout = TIMEOUT_MAX)
+        {
+            uint32_t start = pros::millis();
+            bool expected = false;
+
+            while (!held.compare_exchange_strong(expected, true))
+            {
+                if (pros::millis() - start >= timeout)
+                {
+                    return(false);
+                }
+
+                expected = false;
+                pros::delay(1);
+            }
+
+            return(true);
+        }
+
+        void give()
+        {
+            held = false;
+        }
+};
+
 double util::dtr(double input)
 {
   return(PI * input/180);
@@ -0,0 +1,100 @@
+#ifndef __VELOCITY__
+#define __VELOCITY__
+
+#include "main.h"
+#include "battery.hpp"
+#include "pros/rtos.hpp"
+#include "telemetry.hpp"
+#include "util.hpp"
+#include <cmath>
+#include <cstdint>
+
+/* closed loop wheel speed for the drive. each side is feedforward on the target speed plus pi on the measured speed,
+and the whole output goes through battery::compensate() so the same target is the same speed on a full and a sagging
+battery. group::chassis runs one of these per side when closedLoop is on, see spinVel() and spinDiffy() in global.hpp
+*/
+namespace velocity
+{
+    // - drive geometry, 600rpm motors
+    const double wheelDiameter = 3.25;
+    const double ratio = 0.6;           // wheel turns per motor turn
+
+    // wheel inches per second from motor rpm
+    double ips(double rpm)
+    {
+        return rpm * ratio * wheelDiameter * PI / 60;
+    }
+
+    // what 127 gets on a nominal battery, the primitives' -127 to 127 is a fraction of this
+    const double topSpeed = ips(600);
+
+    // volts are in move() units, 127 = 12V
+    struct gains
+    {
+        double ks;      // static friction
+        double kv;      // per in/s
+        double kp;      // per in/s of error
+        double ki;      // per inch of accumulated error
+        double iLimit;  // inches
+    };
+
+    gains drive = {4, 127 / topSpeed, 1.5, 6, 8};
+
+    /* in/s. a pid settling on its target asks for small speeds of either sign, below this there is no ks kick and the
+    direction doesnt count as changed, so the output doesnt chatter and the integral holds through the settle
+    */
+    const double deadband = 1.5;
+
+    const uint16_t leftLog = telemetry::define("drive.left", "target,speed,voltage");
+    const uint16_t rightLog = telemetry::define("drive.right", "target,speed,voltage");
+
+    class side
+    {
+        private:
+            uint16_t channel;
+            double integral = 0;
+            double direction = 0;   // sign of the last target outside the deadband
+            uint32_t last = 0;
+
+        public:
+            side(uint16_t log) : channel(log) {}
+
+            // target and speed in in/s, returns move() volts
+            double out(double target, double speed)
+            {
+                uint32_t now = pros::millis();
+                double dt = last == 0 || now - last > 100 ? 0 : (now - last) / 1000.0;
+                double error = target - speed;
+                last = now;
+
+                // reversing shouldn't carry the old correction
+                if (std::abs(target) > deadband)
+                {
+                    if (util::sign(target) != direction)
+                    {
+                        integral = 0;
+                    }
+
+                    direction = util::sign(target);
+                }
+
+                integral += error * dt;
+                integral = integral > drive.iLimit ? drive.iLimit : integral < -drive.iLimit ? -drive.iLimit : integral;
+
+                double volts = (std::abs(target) > deadband ? drive.ks * util::sign(target) : 0) + drive.kv * target;
+                volts = battery::compensate(volts + drive.kp * error + drive.ki * integral);
+
+                telemetry::record(channel, target, speed, volts);
+                return(volts);
+            }
+
+            void reset()
+            {
+                integral = 0;
+                direction = 0;
+                last = 0;
+            }
+    };
+}
+
+#endif
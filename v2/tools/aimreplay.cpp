@@ -0,0 +1,241 @@
+/* replays a /usd/visionN.csv recording through the goal tracker and the aim pid against a simple drivetrain model,
+so aim gains can be tuned at a desk.
+
+    g++ -std=c++17 -O2 -I tools/host -I src tools/aimreplay.cpp -o aimreplay
+    ./aimreplay vision0.csv [--sig 2] [--kp 0.6] [--ki 0.1] [--kd 0] [--gain 3] [--tau 0.1] [--start 20]
+
+the recording is only used for what the robot cant simulate: the goal's heading is fitted from the recorded
+(heading, left_coord) pairs and the blob noise and dropouts of every frame are played back on top of the simulated
+heading. --gain is turn rate in deg/s per voltage unit and --tau the drivetrain time constant in seconds. prints
+time to lock and the residual error after lock
+*/
+
+#include "tracker.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct frame
+{
+    int time;
+    double heading;
+    std::vector<pros::vision_object_s_t> objects;
+};
+
+std::vector<frame> load(const char* path)
+{
+    std::ifstream file(path);
+    std::string line;
+    std::vector<frame> frames;
+
+    std::getline(file, line);
+
+    while (std::getline(file, line))
+    {
+        int time, sig, left, top, width, height;
+        double heading;
+
+        if (sscanf(line.c_str(), "%d,%lf,%d,%d,%d,%d,%d", &time, &heading, &sig, &left, &top, &width, &height) != 7)
+        {
+            continue;
+        }
+
+        // an older recording that spans a power cycle starts over, only the first run is replayed
+        if (!frames.empty() && time < frames.back().time)
+        {
+            fprintf(stderr, "timestamps go backwards at %d ms, ignoring the rest\n", time);
+            break;
+        }
+
+        if (frames.empty() || frames.back().time != time)
+        {
+            frames.push_back(frame{time, heading, {}});
+        }
+
+        if (sig != 0)
+        {
+            pros::vision_object_s_t blob{};
+            blob.signature = sig;
+            blob.left_coord = left;
+            blob.top_coord = top;
+            blob.width = width;
+            blob.height = height;
+            frames.back().objects.push_back(blob);
+        }
+    }
+
+    return frames;
+}
+
+double wrap(double deg)
+{
+    while (deg > 180) deg -= 360;
+    while (deg < -180) deg += 360;
+    return deg;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s vision.csv [--sig n] [--kp p] [--ki i] [--kd d] [--gain deg/s/unit] [--tau s] [--start deg]\n", argv[0]);
+        return 1;
+    }
+
+    int sig = aim::blueSig;
+    util::pidConstants cons = aim::constants;
+    double gain = 3;
+    double tau = 0.1;
+    double startOffset = 20;
+
+    for (int i = 2; i + 1 < argc; i += 2)
+    {
+        double v = atof(argv[i + 1]);
+
+        if (!strcmp(argv[i], "--sig")) sig = v;
+        else if (!strcmp(argv[i], "--kp")) cons.p = v;
+        else if (!strcmp(argv[i], "--ki")) cons.i = v;
+        else if (!strcmp(argv[i], "--kd")) cons.d = v;
+        else if (!strcmp(argv[i], "--gain")) gain = v;
+        else if (!strcmp(argv[i], "--tau")) tau = v;
+        else if (!strcmp(argv[i], "--start")) startOffset = v;
+    }
+
+    std::vector<frame> frames = load(argv[1]);
+
+    // biggest blob of the signature in each frame, for the fit
+    std::vector<double> hs, xs;
+    std::vector<int> biggest(frames.size(), -1);
+
+    for (size_t f = 0; f < frames.size(); f++)
+    {
+        int area = 0;
+
+        for (size_t i = 0; i < frames[f].objects.size(); i++)
+        {
+            pros::vision_object_s_t & o = frames[f].objects[i];
+
+            if (o.signature == sig && o.width * o.height > area)
+            {
+                area = o.width * o.height;
+                biggest[f] = i;
+            }
+        }
+
+        if (biggest[f] >= 0)
+        {
+            hs.push_back(wrap(frames[f].heading - frames[0].heading));
+            xs.push_back(frames[f].objects[biggest[f]].left_coord);
+        }
+    }
+
+    if (hs.size() < 10)
+    {
+        fprintf(stderr, "not enough frames with signature %d\n", sig);
+        return 1;
+    }
+
+    // x = a + b * heading, the goal doesnt move so b is pixels per degree and the residuals are sensor noise
+    double mh = 0, mx = 0, shh = 0, shx = 0;
+
+    for (size_t i = 0; i < hs.size(); i++)
+    {
+        mh += hs[i];
+        mx += xs[i];
+    }
+
+    mh /= hs.size();
+    mx /= hs.size();
+
+    for (size_t i = 0; i < hs.size(); i++)
+    {
+        shh += (hs[i] - mh) * (hs[i] - mh);
+        shx += (hs[i] - mh) * (xs[i] - mx);
+    }
+
+    if (shh < 1)
+    {
+        fprintf(stderr, "heading barely changes in the recording, using 5 px/deg\n");
+    }
+
+    double b = shh < 1 ? -5 : shx / shh;
+    double a = mx - b * mh;
+    double lockHeading = (aim::center(sig) - a) / b;
+
+    printf("frames %zu, %.2f px/deg, lined up at %.1f deg\n", frames.size(), b, lockHeading);
+
+    // simulate
+    aim::tracker filter;
+    util::pid pid(cons, 1000);
+    pid.pinIntegralThreshold();
+    aim::target goal{};
+    double heading = lockHeading + startOffset;
+    double rate = 0;
+    int start = frames[0].time;
+    int end = frames.back().time;
+    size_t next = 0;
+    int lockTime = -1;
+    int inRange = 0;
+    double sumSq = 0;
+    int samples = 0;
+
+    for (int t = start; t <= end; t += 10)
+    {
+        // vision frames arrive at the recorded times
+        while (next < frames.size() && frames[next].time <= t)
+        {
+            std::vector<pros::vision_object_s_t> objects = frames[next].objects;
+
+            if (biggest[next] >= 0)
+            {
+                pros::vision_object_s_t & o = objects[biggest[next]];
+                double noise = o.left_coord - (a + b * wrap(frames[next].heading - frames[0].heading));
+                o.left_coord = std::lround(a + b * heading + noise);
+            }
+
+            goal = filter.update(objects.data(), objects.size(), sig);
+            next++;
+        }
+
+        double vel = goal.visible ? pid.out(goal.error) : 0;
+        vel = std::max(-127.0, std::min(127.0, vel));
+
+        // spinDiffy(-vel, vel) drives the left side with -vel (the first half of the motors are the left ones) so a
+        // positive output turns counterclockwise
+        rate += (-gain * vel - rate) * 0.01 / tau;
+        heading += rate * 0.01;
+
+        double error = std::abs(aim::center(sig) - (a + b * heading));
+
+        if (lockTime < 0)
+        {
+            inRange = error < 2 ? inRange + 10 : 0;
+
+            if (inRange >= 200)
+            {
+                lockTime = t - start - 200;
+            }
+        }
+
+        else
+        {
+            sumSq += error * error;
+            samples++;
+        }
+    }
+
+    if (lockTime < 0)
+    {
+        printf("never locked\n");
+        return 2;
+    }
+
+    printf("time to lock   %d ms\n", lockTime);
+    printf("residual rms   %.2f px (%.2f deg)\n", std::sqrt(sumSq / std::max(samples, 1)), std::sqrt(sumSq / std::max(samples, 1)) / std::abs(b));
+    return 0;
+}
@@ -0,0 +1,308 @@
+#!/usr/bin/env python3
+"""compiles an auton script (.auton) into the bytecode script.hpp runs. copy the output to the sd card as auton.aut
+and pick "sdAuton" in the selector.
+
+    python3 autonc.py ../scripts/wp.auton                   writes wp.aut
+    python3 autonc.py ../scripts/wp.auton -o /media/sd/auton.aut
+    python3 autonc.py wp.aut --dump                         lists the steps in a compiled file
+
+script format, one step per line, # starts a comment:
+
+    include pid.auton                   steps and consts from another file, relative to this one
+    const smallTurn 10 1.6 2 0.05 7 10  a name for one or more numbers, usable anywhere a number is
+    flywheel 475
+    spinTo 357.7 800 smallTurn          trailing arguments with a default can be left off
+    goal -120 120                       where volleys aim, in the odom frame of where this auton starts
+    parallel                            every step inside runs at the same time, the block ends when they all have
+        drive 6150 2300 20
+        sequence                        steps inside run one after another as one branch of the parallel
+            intake 127
+            wait 1500
+            intakeStop c
+        end
+    end
+
+a pid is six numbers, p i d tolerance integralThreshold maxIntegral, the same as util::pidConstants. brake modes are
+c b h, pistons are tsukasa cata plane angler and their state is on off toggle
+
+flywheel::waitReady only wakes one task, so only one branch of a parallel can use waitReady or waitIndex. the robot
+refuses a file that breaks that, or has an argument out of range, when it loads it (script::check in bytecode.hpp)
+"""
+
+import argparse
+import math
+import os
+import struct
+import sys
+
+PID = 6
+
+# name: (opcode, [(argument, count, default)]), the opcodes and number of floats have to match script.hpp
+OPS = {
+    "wait":             (1, [("ms", 1, None)]),
+    "spinTo":           (2, [("target", 1, None), ("timeout", 1, None), ("pid", PID, [3.7, 1.3, 26, 0.05, 2.4, 20])]),
+    "drive":            (3, [("target", 1, None), ("timeout", 1, None), ("tolerance", 1, None)]),
+    "autoDrive":        (4, [("target", 1, None), ("heading", 1, None), ("timeout", 1, None),
+                             ("lCons", PID, [0.3, 0.2, 2.4, 5, 30, 1000]), ("aCons", PID, [4, 0.7, 4, 0, 190, 20])]),
+    "odomDrive":        (5, [("distance", 1, None), ("timeout", 1, None), ("tolerance", 1, None)]),
+    "moveTo":           (6, [("x", 1, None), ("y", 1, None), ("timeout", 1, None), ("lCons", PID, None),
+                             ("rCons", PID, None), ("rotationBias", 1, None), ("rotationScale", 1, None),
+                             ("rotationCut", 1, None)]),
+    "timedSpin":        (7, [("target", 1, None), ("speed", 1, None), ("timeout", 1, None)]),
+    "velsUntilHeading": (8, [("left", 1, None), ("right", 1, None), ("heading", 1, None), ("tolerance", 1, None),
+                             ("timeout", 1, None)]),
+    "arcTurn":          (9, [("theta", 1, None), ("radius", 1, None), ("timeout", 1, None), ("pid", PID, None)]),
+    "chassis":          (10, [("left", 1, None), ("right", 1, None)]),
+    "chassisStop":      (11, [("brake", 1, None)]),
+    "intake":           (12, [("volts", 1, None)]),
+    "intakeStop":       (13, [("brake", 1, None)]),
+    "index":            (14, [("discs", 1, None)]),
+    "waitIndex":        (15, [("discs", 1, None), ("tolerance", 1, [5]), ("ff", 1, [-1]), ("time", 1, [50]),
+                              ("ffTime", 1, [0]), ("timeout", 1, [3000])]),
+    "toggle":           (16, [("ym", 1, None), ("timeLimit", 1, [1000])]),
+    "flywheel":         (17, [("rpm", 1, None)]),
+    "waitReady":        (18, [("tolerance", 1, None), ("hold", 1, None), ("timeout", 1, None)]),
+    "piston":           (19, [("piston", 1, None), ("state", 1, None)]),
+    "volley":           (20, [("discs", 1, None)]),
+    "waitVolley":       (21, [("timeout", 1, None)]),
+    "aim":              (22, [("timeout", 1, None), ("sig", 1, None)]),
+    "goal":             (24, [("x", 1, None), ("y", 1, None)]),
+}
+
+PARALLEL = 23
+
+# argument values script::validArgs in bytecode.hpp refuses, by position: (lowest, highest, whole numbers only)
+LIMITS = {
+    "wait":        {0: (0, float("inf"), False)},
+    "chassisStop": {0: (0, 2, True)},
+    "intakeStop":  {0: (0, 2, True)},
+    "index":       {0: (0, 255, True)},
+    "waitIndex":   {0: (0, 255, True)},
+    "piston":      {0: (0, 3, True), 1: (0, 2, True)},
+    "volley":      {0: (0, 255, True)},
+}
+
+WAITERS = {OPS["waitReady"][0], OPS["waitIndex"][0]}
+MAGIC = b"AUT1"
+
+WORDS = {
+    "c": 0, "b": 1, "h": 2,
+    "tsukasa": 0, "cata": 1, "plane": 2, "angler": 3,
+    "off": 0, "on": 1, "toggle": 2,
+    "false": 0, "true": 1,
+}
+
+NAMES = {code: name for name, (code, _) in OPS.items()}
+
+
+class ScriptError(Exception):
+    pass
+
+
+class Compiler:
+    def __init__(self):
+        self.consts = {}
+        self.including = []
+
+    def lines(self, path):
+        """every step in a file with includes expanded, as (where, words)"""
+        path = os.path.abspath(path)
+        if path in self.including:
+            raise ScriptError(f"{path}: includes itself")
+        self.including.append(path)
+
+        try:
+            with open(path) as f:
+                source = f.read().splitlines()
+        except OSError as e:
+            raise ScriptError(f"{path}: {e.strerror}")
+
+        for number, line in enumerate(source, 1):
+            where = f"{os.path.basename(path)}:{number}"
+            words = line.split("#", 1)[0].split()
+            if not words:
+                continue
+
+            if words[0] == "include":
+                if len(words) != 2:
+                    raise ScriptError(f"{where}: include takes one file")
+                yield from self.lines(os.path.join(os.path.dirname(path), words[1]))
+
+            elif words[0] == "const":
+                if len(words) < 3:
+                    raise ScriptError(f"{where}: const needs a name and at least one number")
+                if words[1] in WORDS or words[1] in OPS:
+                    raise ScriptError(f"{where}: {words[1]} is already a keyword")
+                self.consts[words[1]] = self.numbers(where, words[2:])
+
+            else:
+                yield where, words
+
+        self.including.pop()
+
+    def numbers(self, where, words):
+        out = []
+        for word in words:
+            if word in self.consts:
+                out.extend(self.consts[word])
+            elif word in WORDS:
+                out.append(float(WORDS[word]))
+            else:
+                try:
+                    out.append(float(word))
+                except ValueError:
+                    raise ScriptError(f"{where}: {word} isn't a number, const or keyword")
+        return out
+
+    def step(self, where, words):
+        if words[0] not in OPS:
+            raise ScriptError(f"{where}: unknown step {words[0]}")
+
+        code, args = OPS[words[0]]
+        given = self.numbers(where, words[1:])
+        values = []
+
+        for name, count, default in args:
+            if len(given) >= count:
+                values.extend(given[:count])
+                given = given[count:]
+            elif not given and default is not None:
+                values.extend(default)
+            else:
+                raise ScriptError(f"{where}: {words[0]} is missing {name} ({count} number{'s' if count > 1 else ''})")
+
+        if given:
+            raise ScriptError(f"{where}: {words[0]} has {len(given)} numbers too many")
+
+        for i, value in enumerate(values):
+            low, high, whole = LIMITS.get(words[0], {}).get(i, (-float("inf"), float("inf"), False))
+            if not math.isfinite(value) or not low <= value <= high or (whole and value != int(value)):
+                raise ScriptError(f"{where}: {words[0]} can't take {value:g}")
+
+        return struct.pack("<B", code) + struct.pack(f"<{len(values)}f", *values)
+
+    def block(self, steps, closed):
+        """compiles steps until end (when closed) or the end of the input"""
+        out = b""
+        for where, words in steps:
+            if words[0] == "end":
+                if not closed:
+                    raise ScriptError(f"{where}: end without a block")
+                return out
+            out += self.statement(where, words, steps)
+        if closed:
+            raise ScriptError("a parallel or sequence block is missing its end")
+        return out
+
+    def statement(self, where, words, steps):
+        if words[0] == "sequence":
+            return self.block(steps, True)
+
+        if words[0] == "parallel":
+            branches = []
+            for inner, innerWords in steps:
+                if innerWords[0] == "end":
+                    break
+                branches.append(self.statement(inner, innerWords, steps))
+            else:
+                raise ScriptError(f"{where}: parallel is missing its end")
+
+            if not 1 <= len(branches) <= 255:
+                raise ScriptError(f"{where}: a parallel needs 1 to 255 branches")
+
+            if sum(waits(branch) for branch in branches) > 1:
+                raise ScriptError(f"{where}: only one branch of a parallel can waitReady or waitIndex")
+
+            out = struct.pack("<BB", PARALLEL, len(branches))
+            for branch in branches:
+                out += struct.pack("<I", len(branch)) + branch
+            return out
+
+        return self.step(where, words)
+
+    def compile(self, path):
+        code = self.block(iter(self.lines(path)), False)
+        return MAGIC + struct.pack("<I", len(code)) + code
+
+
+def steps(code):
+    """every (opcode, position) in compiled code, including inside parallels"""
+    pos = 0
+    while pos < len(code):
+        op = code[pos]
+        yield op, pos
+        pos += 1
+
+        if op == PARALLEL:
+            branches = code[pos]
+            pos += 1
+            for _ in range(branches):
+                (length,) = struct.unpack_from("<I", code, pos)
+                pos += 4
+                yield from ((o, pos + p) for o, p in steps(code[pos:pos + length]))
+                pos += length
+            continue
+
+        pos += 4 * sum(c for _, c, _ in OPS[NAMES[op]][1])
+
+
+def waits(code):
+    return any(op in WAITERS for op, _ in steps(code))
+
+
+def dump(code, indent=0, out=sys.stdout):
+    pos = 0
+    while pos < len(code):
+        op = code[pos]
+        pos += 1
+
+        if op == PARALLEL:
+            branches = code[pos]
+            pos += 1
+            print("    " * indent + "parallel", file=out)
+            for _ in range(branches):
+                (length,) = struct.unpack_from("<I", code, pos)
+                pos += 4
+                print("    " * (indent + 1) + "sequence", file=out)
+                dump(code[pos:pos + length], indent + 2, out)
+                print("    " * (indent + 1) + "end", file=out)
+                pos += length
+            print("    " * indent + "end", file=out)
+            continue
+
+        name = NAMES[op]
+        count = sum(c for _, c, _ in OPS[name][1])
+        values = struct.unpack_from(f"<{count}f", code, pos)
+        pos += 4 * count
+        print("    " * indent + name + " " + " ".join(f"{v:g}" for v in values), file=out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="compile an auton script for script.hpp")
+    parser.add_argument("script")
+    parser.add_argument("-o", "--output", help="defaults to the script name with .aut")
+    parser.add_argument("--dump", action="store_true", help="list the steps in a compiled .aut instead")
+    args = parser.parse_args()
+
+    if args.dump:
+        with open(args.script, "rb") as f:
+            data = f.read()
+        if data[:4] != MAGIC:
+            sys.exit(f"{args.script}: not a compiled auton")
+        (length,) = struct.unpack_from("<I", data, 4)
+        dump(data[8:8 + length])
+        return
+
+    try:
+        data = Compiler().compile(args.script)
+    except ScriptError as e:
+        sys.exit(str(e))
+
+    output = args.output or os.path.splitext(os.path.basename(args.script))[0] + ".aut"
+    with open(output, "wb") as f:
+        f.write(data)
+    print(f"{output}: {len(data)} bytes")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,114 @@
+/* runs a compiled auton through the same load and check the robot does, so a file can be tried before it goes on
+the sd card, and so the check itself can be fuzzed.
+
+    g++ -std=c++17 -O2 -fsanitize=address,undefined -I src tools/autoncheck.cpp -o autoncheck
+    ./autoncheck wp.aut [--fuzz 10000]
+
+--fuzz also cuts the file short at every length and flips random bytes in it, each one has to load cleanly or be
+refused without reading past the code. a cut file must always be refused
+*/
+
+#include "bytecode.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+std::vector<uint8_t> readFile(const char* path)
+{
+    std::vector<uint8_t> bytes;
+    FILE* f = fopen(path, "rb");
+
+    if (f == nullptr)
+    {
+        return bytes;
+    }
+
+    int c;
+    while ((c = fgetc(f)) != EOF)
+    {
+        bytes.push_back(c);
+    }
+
+    fclose(f);
+    return bytes;
+}
+
+void writeFile(const char* path, const std::vector<uint8_t>& bytes, size_t length)
+{
+    FILE* f = fopen(path, "wb");
+    fwrite(bytes.data(), 1, length, f);
+    fclose(f);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: autoncheck file.aut [--fuzz n]\n");
+        return 2;
+    }
+
+    int fuzz = 0;
+
+    for (int i = 2; i + 1 < argc; i += 2)
+    {
+        if (strcmp(argv[i], "--fuzz") == 0)
+        {
+            fuzz = atoi(argv[i + 1]);
+        }
+    }
+
+    std::vector<uint8_t> code;
+
+    if (!script::load(argv[1], code))
+    {
+        printf("%s: refused\n", argv[1]);
+        return 1;
+    }
+
+    printf("%s: %zu bytes of code ok\n", argv[1], code.size());
+
+    if (fuzz == 0)
+    {
+        return 0;
+    }
+
+    std::vector<uint8_t> file = readFile(argv[1]);
+    const char* scratch = "autoncheck.tmp";
+    int failed = 0;
+
+    // every cut keeps the header's length, which is then longer than the file
+    for (size_t length = 0; length < file.size(); length++)
+    {
+        writeFile(scratch, file, length);
+
+        if (script::load(scratch, code))
+        {
+            printf("cut at %zu loaded\n", length);
+            failed++;
+        }
+    }
+
+    std::mt19937 rng(1);
+    int loaded = 0;
+
+    for (int i = 0; i < fuzz; i++)
+    {
+        std::vector<uint8_t> bad = file;
+        int flips = 1 + rng() % 4;
+
+        for (int j = 0; j < flips; j++)
+        {
+            bad[rng() % bad.size()] = rng();
+        }
+
+        writeFile(scratch, bad, bad.size());
+        loaded += script::load(scratch, code);
+    }
+
+    remove(scratch);
+
+    printf("%zu cuts refused, %d of %d corrupted files still loaded\n", file.size() - failed, loaded, fuzz);
+    return failed > 0;
+}
@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+"""fits the flywheel feedforward model  voltage = ks * sign(v) + kv * v + ka * a
+from the log written by flywheel::characterize() (/usd/fwchar.csv).
+
+    python3 fwfit.py fwchar.csv
+
+prints the fitted constants and an "ff" line that can be pasted into flywheel.cfg
+"""
+
+import argparse
+import csv
+import sys
+
+
+def load(path):
+    times, volts, vels = [], [], []
+    with open(path) as f:
+        for row in csv.DictReader(f):
+            times.append(float(row["time"]) / 1000)
+            volts.append(float(row["voltage"]))
+            vels.append(float(row["velocity"]))
+    return times, volts, vels
+
+
+def smooth(values, window):
+    half = window // 2
+    out = []
+    for i in range(len(values)):
+        chunk = values[max(0, i - half):i + half + 1]
+        out.append(sum(chunk) / len(chunk))
+    return out
+
+
+def accelerations(times, vels):
+    acc = [0.0] * len(vels)
+    for i in range(1, len(vels) - 1):
+        dt = times[i + 1] - times[i - 1]
+        acc[i] = (vels[i + 1] - vels[i - 1]) / dt if dt > 0 else 0.0
+    return acc
+
+
+def solve(a, b):
+    """gaussian elimination with partial pivoting"""
+    n = len(b)
+    m = [row[:] + [b[i]] for i, row in enumerate(a)]
+    for col in range(n):
+        pivot = max(range(col, n), key=lambda r: abs(m[r][col]))
+        if abs(m[pivot][col]) < 1e-12:
+            raise ValueError("singular system, not enough excitation in the log")
+        m[col], m[pivot] = m[pivot], m[col]
+        for r in range(n):
+            if r != col:
+                f = m[r][col] / m[col][col]
+                for c in range(col, n + 1):
+                    m[r][c] -= f * m[col][c]
+    return [m[i][n] / m[i][i] for i in range(n)]
+
+
+def fit(rows):
+    """least squares on rows of (features, target)"""
+    n = len(rows[0][0])
+    ata = [[0.0] * n for _ in range(n)]
+    atb = [0.0] * n
+    for x, y in rows:
+        for i in range(n):
+            atb[i] += x[i] * y
+            for j in range(n):
+                ata[i][j] += x[i] * x[j]
+    coeffs = solve(ata, atb)
+
+    mean = sum(y for _, y in rows) / len(rows)
+    ssRes = sum((y - sum(c * xi for c, xi in zip(coeffs, x))) ** 2 for x, y in rows)
+    ssTot = sum((y - mean) ** 2 for _, y in rows)
+    return coeffs, 1 - ssRes / ssTot if ssTot > 0 else 0.0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("log")
+    parser.add_argument("--min-speed", type=float, default=20, help="ignore samples slower than this (rpm)")
+    parser.add_argument("--window", type=int, default=9, help="velocity smoothing window (samples)")
+    args = parser.parse_args()
+
+    times, volts, vels = load(args.log)
+    if len(times) < 10:
+        sys.exit("log is too short")
+
+    vels = smooth(vels, args.window)
+    accs = accelerations(times, vels)
+
+    rows = []
+    for v, a, u in zip(vels, accs, volts):
+        if abs(v) < args.min_speed or u == 0:
+            continue
+        rows.append(([1.0 if v > 0 else -1.0, v, a], u))
+
+    if len(rows) < 3:
+        sys.exit("not enough samples above --min-speed")
+
+    (ks, kv, ka), r2 = fit(rows)
+
+    print("samples  %d" % len(rows))
+    print("ks       %.6f" % ks)
+    print("kv       %.6f" % kv)
+    print("ka       %.6f" % ka)
+    print("r^2      %.4f" % r2)
+    print()
+    print("ff %.6f %.6f %.6f" % (ks, kv, ka))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,58 @@
+#ifndef __HOST_MAIN__
+#define __HOST_MAIN__
+
+/* stands in for the pros main.h when src headers that only do maths are built on a computer for the tools in this
+folder. time is simulated, tools move it forward with pros::host::advance()
+*/
+
+#include <cstdint>
+#include <cstdio>
+
+#define TIMEOUT_MAX ((uint32_t)0xffffffffUL)
+
+namespace pros
+{
+    namespace host
+    {
+        inline uint64_t& clock()
+        {
+            static uint64_t micros = 0;
+            return micros;
+        }
+
+        inline void advance(uint32_t ms)
+        {
+            clock() += ms * 1000;
+        }
+    }
+
+    inline uint32_t millis()
+    {
+        return host::clock() / 1000;
+    }
+
+    inline uint64_t micros()
+    {
+        return host::clock();
+    }
+
+    inline void delay(uint32_t ms)
+    {
+        host::advance(ms);
+    }
+
+    struct vision_object_s_t
+    {
+        uint16_t signature;
+        int type;
+        int16_t left_coord;
+        int16_t top_coord;
+        int16_t width;
+        int16_t height;
+        uint16_t angle;
+        int16_t x_middle_coord;
+        int16_t y_middle_coord;
+    };
+}
+
+#endif
@@ -0,0 +1,243 @@
+#!/usr/bin/env python3
+"""reads the serial telemetry stream from stream.hpp, live from the brain or replayed from a capture. the robot code
+has to be built with -DSERIAL_TELEMETRY for the brain to send it.
+
+    python3 plot.py --port /dev/ttyACM1 --save run.raw            capture, prints a line per second
+    python3 plot.py --port /dev/ttyACM1 -p flywheel.speed -p flywheel.target
+    python3 plot.py --replay run.raw -p flywheel.speed --realtime
+    python3 plot.py --replay run.raw --csv out/                   one csv per channel
+
+--port needs pyserial and -p needs matplotlib, nothing else does. text the robot printf's in between frames is
+echoed with --text
+"""
+
+import argparse
+import collections
+import os
+import struct
+import sys
+import time
+
+SYNC = b"\xaa\x55"
+CHANNEL = 1
+ENTRY = 2
+ENTRY_FORMAT = struct.Struct("<IHH3f")
+
+
+def crc16(data, crc=0xFFFF):
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) & 0xFFFF if crc & 0x8000 else (crc << 1) & 0xFFFF
+    return crc
+
+
+class Decoder:
+    """feed() it bytes in whatever chunks they arrive, it yields ("channel", id, name, fields),
+    ("entry", seconds, id, aux, values) and ("text", bytes) for anything that isn't a valid frame"""
+
+    def __init__(self):
+        self.buffer = bytearray()
+        self.bad = 0
+        self.wraps = 0
+        self.prev = 0
+
+    def feed(self, data):
+        self.buffer += data
+        while True:
+            start = self.buffer.find(SYNC)
+            if start < 0:
+                # keep a trailing 0xaa, it might be the start of the next sync
+                keep = 1 if self.buffer.endswith(SYNC[:1]) else 0
+                text = bytes(self.buffer[:len(self.buffer) - keep])
+                del self.buffer[:len(self.buffer) - keep]
+                if text:
+                    yield ("text", text)
+                return
+            if start > 0:
+                yield ("text", bytes(self.buffer[:start]))
+                del self.buffer[:start]
+
+            if len(self.buffer) < 4:
+                return
+            length = self.buffer[3]
+            if len(self.buffer) < length + 6:
+                return
+
+            body = bytes(self.buffer[2:4 + length])
+            crc = self.buffer[4 + length] | self.buffer[5 + length] << 8
+            if crc != crc16(body):
+                # not a frame, or a corrupt one. skip the sync and look for the next
+                self.bad += 1
+                yield ("text", bytes(self.buffer[:2]))
+                del self.buffer[:2]
+                continue
+
+            del self.buffer[:length + 6]
+            kind, payload = body[0], body[2:]
+            if kind == CHANNEL:
+                cid = payload[0] | payload[1] << 8
+                name, _, fields = payload[2:].decode(errors="replace").partition(" ")
+                yield ("channel", cid, name, fields.split(","))
+            elif kind == ENTRY and len(payload) == ENTRY_FORMAT.size:
+                micros, cid, aux, a, b, c = ENTRY_FORMAT.unpack(payload)
+                if micros < self.prev and self.prev - micros > 1 << 31:
+                    self.wraps += 1
+                self.prev = micros
+                yield ("entry", (micros + (self.wraps << 32)) / 1e6, cid, aux, (a, b, c))
+
+
+def serial_source(port, baud):
+    try:
+        import serial
+    except ImportError:
+        sys.exit("--port needs pyserial (pip install pyserial)")
+    link = serial.Serial(port, baud, timeout=0.05)
+    while True:
+        data = link.read(4096)
+        if data:
+            yield data
+
+
+def replay_source(path, realtime):
+    """yields the capture in chunks. with realtime the chunks are spaced out by the entry timestamps"""
+    with open(path, "rb") as f:
+        data = f.read()
+    if not realtime:
+        yield data
+        return
+
+    pacer = Decoder()
+    started = None
+    chunk = 4096
+    for i in range(0, len(data), chunk):
+        piece = data[i:i + chunk]
+        for event in pacer.feed(piece):
+            if event[0] == "entry":
+                if started is None:
+                    started = (time.time(), event[1])
+                wait = (event[1] - started[1]) - (time.time() - started[0])
+                if wait > 0:
+                    time.sleep(wait)
+        yield piece
+
+
+class Plotter:
+    def __init__(self, series, window):
+        try:
+            import matplotlib.pyplot as plt
+        except ImportError:
+            sys.exit("-p needs matplotlib (pip install matplotlib)")
+        self.plt = plt
+        self.series = series
+        self.window = window
+        self.data = {s: (collections.deque(), collections.deque()) for s in series}
+        plt.ion()
+        self.figure, self.axes = plt.subplots()
+        self.lines = {s: self.axes.plot([], [], label=s)[0] for s in series}
+        self.axes.legend(loc="upper left")
+        self.axes.set_xlabel("seconds")
+        self.drawn = 0
+
+    def add(self, name, seconds, value):
+        times, values = self.data[name]
+        times.append(seconds)
+        values.append(value)
+        while times and times[0] < seconds - self.window:
+            times.popleft()
+            values.popleft()
+
+    def draw(self, force=False):
+        # redrawing is the slow part, 20 times a second is plenty
+        if not force and time.time() - self.drawn < 0.05:
+            return
+        self.drawn = time.time()
+        for name, line in self.lines.items():
+            line.set_data(self.data[name][0], self.data[name][1])
+        self.axes.relim()
+        self.axes.autoscale_view()
+        self.plt.pause(0.001)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("--port", help="serial port of the brain or controller")
+    source.add_argument("--replay", help="raw capture written by --save")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--realtime", action="store_true", help="replay at the speed it was recorded")
+    parser.add_argument("--save", help="append the raw bytes to this file for --replay later")
+    parser.add_argument("--csv", help="directory to write one csv per channel into")
+    parser.add_argument("-p", "--plot", action="append", default=[], metavar="CHANNEL.FIELD")
+    parser.add_argument("--window", type=float, default=10, help="seconds of data to plot")
+    parser.add_argument("--text", action="store_true", help="echo printf output from the robot")
+    args = parser.parse_args()
+
+    chunks = serial_source(args.port, args.baud) if args.port else replay_source(args.replay, args.realtime)
+    decoder = Decoder()
+    channels = {}
+    counts = collections.Counter()
+    files = {}
+    plotter = Plotter(args.plot, args.window) if args.plot else None
+    save = open(args.save, "ab") if args.save else None
+    status = time.time()
+
+    if args.csv:
+        os.makedirs(args.csv, exist_ok=True)
+
+    try:
+        for chunk in chunks:
+            if save:
+                save.write(chunk)
+            for event in decoder.feed(chunk):
+                if event[0] == "text":
+                    if args.text:
+                        sys.stdout.write(event[1].decode(errors="replace"))
+                elif event[0] == "channel":
+                    channels[event[1]] = (event[2], event[3])
+                else:
+                    _, seconds, cid, aux, values = event
+                    if cid not in channels:
+                        # haven't seen the header for it yet, it gets repeated every couple of seconds
+                        continue
+                    name, fields = channels[cid]
+                    counts[name] += 1
+
+                    if args.csv:
+                        if name not in files:
+                            files[name] = open(os.path.join(args.csv, name + ".csv"), "w")
+                            files[name].write(",".join(["time", "aux"] + fields) + "\n")
+                        files[name].write(",".join(["%.6f" % seconds, str(aux)] +
+                                                   ["%g" % v for v in values[:len(fields)]]) + "\n")
+
+                    if plotter:
+                        for field, value in zip(fields, values):
+                            key = name + "." + field
+                            if key in plotter.data:
+                                plotter.add(key, seconds, value)
+
+            if plotter:
+                plotter.draw()
+            elif not args.text and args.port and time.time() - status >= 1:
+                status = time.time()
+                print(" ".join("%s:%d" % item for item in sorted(counts.items())), "bad:%d" % decoder.bad)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        for f in files.values():
+            f.close()
+        if save:
+            save.close()
+
+    if args.replay:
+        print("%d entries, %d bad frames" % (sum(counts.values()), decoder.bad))
+        for name, count in sorted(counts.items()):
+            print("  %s: %d" % (name, count))
+        if plotter:
+            plotter.draw(force=True)
+            plotter.plt.ioff()
+            plotter.plt.show()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,88 @@
+#!/usr/bin/env python3
+"""decodes a telemetry log written by telemetry.hpp (/usd/tlmN.bin) into csv.
+
+    python3 tlmdecode.py tlm0.bin                 one csv per channel next to the log
+    python3 tlmdecode.py tlm0.bin -c flywheel     a single channel to stdout
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+ENTRY = struct.Struct("<IHH3f")
+
+
+def read_header(f):
+    if f.readline() != b"TLM1\n":
+        raise ValueError("not a telemetry log")
+    channels = {}
+    while True:
+        line = f.readline()
+        if not line:
+            raise ValueError("header is truncated")
+        line = line.decode().strip()
+        if line == "end":
+            return channels
+        _, cid, name, fields = line.split(" ", 3)
+        channels[int(cid)] = (name, fields.split(","))
+
+
+def entries(f):
+    """yields (seconds, channel, aux, values), unwrapping the 32 bit micros counter"""
+    wraps = 0
+    prev = 0
+    while True:
+        raw = f.read(ENTRY.size)
+        if len(raw) < ENTRY.size:
+            return
+        time, channel, aux, a, b, c = ENTRY.unpack(raw)
+        if time < prev and prev - time > 1 << 31:
+            wraps += 1
+        prev = time
+        yield (time + (wraps << 32)) / 1e6, channel, aux, (a, b, c)
+
+
+def load(path):
+    with open(path, "rb") as f:
+        channels = read_header(f)
+        return channels, list(entries(f))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("log")
+    parser.add_argument("-c", "--channel", help="only this channel, written to stdout")
+    args = parser.parse_args()
+
+    channels, rows = load(args.log)
+
+    if args.channel:
+        ids = [cid for cid, (name, _) in channels.items() if name == args.channel]
+        if not ids:
+            sys.exit("no channel named %s, the log has: %s" % (args.channel, ", ".join(n for n, _ in channels.values())))
+        name, fields = channels[ids[0]]
+        print(",".join(["time", "aux"] + fields))
+        for time, cid, aux, values in rows:
+            if cid == ids[0]:
+                print(",".join(["%.6f" % time, str(aux)] + ["%g" % v for v in values[:len(fields)]]))
+        return
+
+    base = os.path.splitext(args.log)[0]
+    files = {}
+    for cid, (name, fields) in channels.items():
+        files[cid] = open("%s_%s.csv" % (base, name), "w")
+        files[cid].write(",".join(["time", "aux"] + fields) + "\n")
+
+    for time, cid, aux, values in rows:
+        if cid in files:
+            fields = channels[cid][1]
+            files[cid].write(",".join(["%.6f" % time, str(aux)] + ["%g" % v for v in values[:len(fields)]]) + "\n")
+
+    for cid, f in files.items():
+        f.close()
+        print("wrote", f.name)
+
+
+if __name__ == "__main__":
+    main()
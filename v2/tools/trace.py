@@ -0,0 +1,87 @@
+#!/usr/bin/env python3
+"""turns the trace events in a telemetry log (see trace.hpp) into chrome trace json. open the output in
+chrome://tracing or ui.perfetto.dev, each lane (chassis, intake, flywheel, auton) gets its own row.
+
+    python3 trace.py tlm0.bin                   writes tlm0.json
+    python3 trace.py tlm0.bin -o skills.json
+    python3 trace.py tlm0.bin --counters        also plots the other channels (flywheel speed etc) as counters
+"""
+
+import argparse
+import json
+import os
+
+from tlmdecode import load
+
+
+def convert(channels, rows, counters=False):
+    lanes = {}
+    events = []
+
+    for cid, (name, fields) in channels.items():
+        if name.startswith("trace."):
+            lane = name.split(".")[1]
+            lanes.setdefault(lane, len(lanes) + 1)
+
+    for lane, tid in lanes.items():
+        events.append({"name": "thread_name", "ph": "M", "pid": 1, "tid": tid, "args": {"name": lane}})
+
+    open_spans = {}
+
+    for time, cid, aux, values in rows:
+        if cid not in channels:
+            continue
+        name, fields = channels[cid]
+        ts = time * 1e6
+
+        if name.startswith("trace."):
+            _, lane, event = name.split(".", 2)
+            begin = values[0] == 1
+            tid = lanes[lane]
+
+            # a log cut off mid event, or an end with nothing open, would throw the nesting off
+            if begin:
+                open_spans[cid] = open_spans.get(cid, 0) + 1
+            elif open_spans.get(cid, 0) == 0:
+                continue
+            else:
+                open_spans[cid] -= 1
+
+            events.append({"name": event, "cat": lane, "ph": "B" if begin else "E", "ts": ts, "pid": 1, "tid": tid,
+                           "args": {"a": values[1], "b": values[2]}})
+
+        elif counters:
+            events.append({"name": name, "ph": "C", "ts": ts, "pid": 1,
+                           "args": {field: value for field, value in zip(fields, values)}})
+
+    # close anything still open at the end of the log so the viewer shows it
+    if rows:
+        last = rows[-1][0] * 1e6
+        for cid, count in open_spans.items():
+            _, lane, event = channels[cid][0].split(".", 2)
+            for _ in range(count):
+                events.append({"name": event, "cat": lane, "ph": "E", "ts": last, "pid": 1, "tid": lanes[lane]})
+
+    return {"traceEvents": events, "displayTimeUnit": "ms"}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("log")
+    parser.add_argument("-o", "--output")
+    parser.add_argument("--counters", action="store_true", help="include the non trace channels as counter tracks")
+    args = parser.parse_args()
+
+    channels, rows = load(args.log)
+    trace = convert(channels, rows, args.counters)
+
+    output = args.output or os.path.splitext(args.log)[0] + ".json"
+    with open(output, "w") as f:
+        json.dump(trace, f)
+
+    spans = sum(1 for e in trace["traceEvents"] if e["ph"] == "B")
+    print("wrote %s, %d spans" % (output, spans))
+
+
+if __name__ == "__main__":
+    main()
@@ -21,8 +21,8 @@ void wp()
     while (true)
     {
         //default motor behavior
-        chassisMotors.stop('c');
-        itsuki.stop('c');
+        chassisMotors.stop(lib::brake::coast);
+        itsuki.stop(lib::brake::coast);
         if (!glb::limit.get_value())
         {
             robot::itsuki.spin(127);
@@ -45,9 +45,8 @@ namespace robot
 {
     std::vector<int> a(100);
     //motors
-    lib::diffy chassisMotors(std::vector<pros::Motor>{glb::frontLeft,glb::midLeft,glb::backLeft, glb::frontRight,glb::midRight,glb::backRight}); 
-    // lib::diffy chassisMotors(std::vector<pros::Motor>{glb::frontRight,glb::midRight,glb::backRight, glb::frontRight,glb::midRight,glb::backRight}); //NOLINT
-    lib::diffy itsuki(std::vector<pros::Motor> {glb::yuuta, glb::saki} ); //NOLINT
+    lib::diffy<3> chassisMotors({glb::frontLeft,glb::midLeft,glb::backLeft}, {glb::frontRight,glb::midRight,glb::backRight}); //NOLINT
+    lib::diffy<1> itsuki({glb::yuuta}, {glb::saki}); //NOLINT
 
     //pistons
     lib::pis boost({glb::boostOne, glb::boostTwo}, true, ""); //NOLINT
@@ -57,11 +56,11 @@ namespace robot
     lib::pis pto({glb::ptoOne, glb::ptoTwo}, true, ""); //NOLINT
 
     //sensors
-    lib::imu imu(glb::imu,0); //NOLINT
+    lib::imu imu(5, 0); // same port as glb::imu //NOLINT
     // lib::limit limit(glb::limit); //NOLINT
 
     //subsytem objects
-    lib::chassis chass(chassisMotors, imu, glb::pos, glb::DL, glb::DR); //NOLINT
+    lib::chassis<3> chass(chassisMotors, imu, glb::pos, glb::DL, glb::DR); //NOLINT
 } 
 
 #endif
\ No newline at end of file
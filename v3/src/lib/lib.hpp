@@ -3,12 +3,13 @@
 
 //include all lib files
 
+#include "robot/devices.hpp"
 #include "robot/groups.hpp"
 #include "robot/chassis.hpp"
 // #include "robot/chassis copy.hpp"
 #include "robot/sensors.hpp"
 #include "robot/util/util.hpp"
 // #include "robot/util/opc.hpp"
-// #include "robot/stager.hpp"
+#include "robot/stager.hpp"
 
 #endif
\ No newline at end of file
@@ -7,25 +7,27 @@
 
 namespace lib
 {
+    // perSide is the motors on each side of the drive, see lib::diffy
+    template <int perSide>
     class chassis
     {
         private:
-            lib::diffy chass;
+            lib::diffy<perSide> chass;
             lib::imu imu;
             util::coordinate pos;
             double DL;
             double DR;
 
         public:
-            chassis(lib::diffy mtrs, lib::imu inertial, util::coordinate position, double dl = 0, double dr = 0) : chass(mtrs), imu(inertial), pos(position), DL(dl), DR(dr) {}
+            chassis(lib::diffy<perSide> mtrs, lib::imu inertial, util::coordinate position, double dl = 0, double dr = 0) : chass(mtrs), imu(inertial), pos(position), DL(dl), DR(dr) {}
 
             void updatePos(double rx, double ry);
             // void spinTo(double target, double timeout, util::pidConstants constants);
-            void spinTo(double target, util::pidConstants constants);
-            void aspin(double target, double timeout, util::pidConstants constants);
+            void spinTo(double target, util::pidConstants constants = util::pidConstants(3.7, 1.3, 26, 0.05, 2.4, 20));
+            void aspin(double target, double timeout, util::pidConstants constants = util::pidConstants(3.7, 1.3, 26, 0.05, 2.4, 20));
             void drive(double target, util::pidConstants constants);
-            // void drive(util::args args);
-            void autoDrive(double target, double heading, double timeout, util::pidConstants lCons, util::pidConstants acons);
+            // void drive(util::args & args);
+            void autoDrive(double target, double heading, double timeout, util::pidConstants lCons = util::pidConstants(0.3,0.2,2.4,5,30,1000), util::pidConstants acons = util::pidConstants(4, 0.7, 4, 0, 190, 20));
             void odomDrive(double distance, double timeout, double tolerance);
             std::vector<double> moveToVel(util::coordinate target, double lkp, double rkp, double rotationBias);
             void moveTo(util::coordinate target, double timeout, util::pidConstants lConstants, util::pidConstants rConstants, double rotationBias, double rotationScale, double rotationCut);
@@ -36,7 +38,8 @@ namespace lib
     };
 }
 
-void lib::chassis::updatePos(double rx, double ry) //NOLINT
+template <int perSide>
+void lib::chassis<perSide>::updatePos(double rx, double ry) //NOLINT
 {
     pos.x += rx;
     pos.y += ry;
@@ -112,7 +115,8 @@ void lib::chassis::updatePos(double rx, double ry) //NOLINT
 //   chass.stop('b');
 // } 
 
-void lib::chassis::spinTo(double target, util::pidConstants constants = util::pidConstants(3.7, 1.3, 26, 0.05, 2.4, 20)) 
+template <int perSide>
+void lib::chassis<perSide>::spinTo(double target, util::pidConstants constants) 
 { 
   double currHeading = imu.degHeading();
   double error;
@@ -167,7 +171,8 @@ void lib::chassis::spinTo(double target, util::pidConstants constants = util::pi
 //   chass.stop('b');
 // } 
 
-void lib::chassis::aspin(double target, double timeout, util::pidConstants constants = util::pidConstants(3.7, 1.3, 26, 0.05, 2.4, 20)) //NOLINT
+template <int perSide>
+void lib::chassis<perSide>::aspin(double target, double timeout, util::pidConstants constants) //NOLINT
 { 
   // timers
   util::timer timeoutTimer;
@@ -215,7 +220,7 @@ void lib::chassis::aspin(double target, double timeout, util::pidConstants const
 
     pros::delay(10);
   }
-  chass.stop('b');
+  chass.stop(lib::brake::brake);
 }
 
 // void lib::chassis::drive(double target, double timeout, util::pidConstants constants) //NOLINT
@@ -246,7 +251,8 @@ void lib::chassis::aspin(double target, double timeout, util::pidConstants const
 //   chass.stop('b');
 // }
 
-void lib::chassis::drive(double target, util::pidConstants constants) //NOLINT
+template <int perSide>
+void lib::chassis<perSide>::drive(double target, util::pidConstants constants) //NOLINT
 {
   static util::pid pid(constants, target);
   chass.spin(pid.out(target - chass.getRotation()));
@@ -314,7 +320,8 @@ void lib::chassis::drive(double target, util::pidConstants constants) //NOLINT
 //   chass.stop('b');
 // } 
 
-void lib::chassis::autoDrive(double target, double heading, double timeout, util::pidConstants lCons = util::pidConstants(0.3,0.2,2.4,5,30,1000), util::pidConstants acons = util::pidConstants(4, 0.7, 4, 0, 190, 20))
+template <int perSide>
+void lib::chassis<perSide>::autoDrive(double target, double heading, double timeout, util::pidConstants lCons, util::pidConstants acons)
 {
   // timers
   util::timer timer;
@@ -369,11 +376,12 @@ void lib::chassis::autoDrive(double target, double heading, double timeout, util
     // glb::controller.print(0, 0, "%f", util::minError(heading, currHeading));
   }
 
-  chass.stop('b');
+  chass.stop(lib::brake::brake);
 }
 
 
-void lib::chassis::odomDrive(double distance, double timeout, double tolerance) //NOLINT
+template <int perSide>
+void lib::chassis<perSide>::odomDrive(double distance, double timeout, double tolerance) //NOLINT
 { 
   
   // resetting timers
@@ -431,10 +439,11 @@ void lib::chassis::odomDrive(double distance, double timeout, double tolerance)
 
     pros::delay(10);
   }
-  chass.stop('b');
+  chass.stop(lib::brake::brake);
 }  
 
-std::vector<double> lib::chassis::moveToVel(util::coordinate target, double lkp, double rkp, double rotationBias) //NOLINT
+template <int perSide>
+std::vector<double> lib::chassis<perSide>::moveToVel(util::coordinate target, double lkp, double rkp, double rotationBias) //NOLINT
 {
   double linearError = distToPoint(pos,target);
   double linearVel = linearError*lkp;
@@ -457,7 +466,8 @@ std::vector<double> lib::chassis::moveToVel(util::coordinate target, double lkp,
   return std::vector<double> {lVel, rVel};
 }
 
-void lib::chassis::moveTo(util::coordinate target, double timeout, util::pidConstants lConstants, util::pidConstants rConstants, double rotationBias, double rotationScale, double rotationCut) //NOLINT
+template <int perSide>
+void lib::chassis<perSide>::moveTo(util::coordinate target, double timeout, util::pidConstants lConstants, util::pidConstants rConstants, double rotationBias, double rotationScale, double rotationCut) //NOLINT
 {
   //init
   util::timer timeoutTimer;
@@ -502,10 +512,11 @@ void lib::chassis::moveTo(util::coordinate target, double timeout, util::pidCons
     chass.spinDiffy(rVel,lVel);
   }
 
-  chass.stop('b');
+  chass.stop(lib::brake::brake);
 }
 
-void lib::chassis::moveToPose(util::bezier curve, double timeout, double lkp, double rkp, double rotationBias) //NOLINT
+template <int perSide>
+void lib::chassis<perSide>::moveToPose(util::bezier curve, double timeout, double lkp, double rkp, double rotationBias) //NOLINT
 {
   
   // resolution in which to sample points along the curve
@@ -552,7 +563,8 @@ void lib::chassis::moveToPose(util::bezier curve, double timeout, double lkp, do
 }
 
 
-void lib::chassis::timedSpin(double target, double speed,double timeout) //NOLINT
+template <int perSide>
+void lib::chassis<perSide>::timedSpin(double target, double speed,double timeout) //NOLINT
 {
   // timers
   util::timer timeoutTimer;
@@ -585,10 +597,11 @@ void lib::chassis::timedSpin(double target, double speed,double timeout) //NOLIN
 
   }
 
-  chass.stop('b');
+  chass.stop(lib::brake::brake);
 }
 
-void lib::chassis::velsUntilHeading(double rvolt, double lvolt, double heading, double tolerance, double timeout) //NOLINT
+template <int perSide>
+void lib::chassis<perSide>::velsUntilHeading(double rvolt, double lvolt, double heading, double tolerance, double timeout) //NOLINT
 {
   util::timer timeoutTimer;
 
@@ -603,7 +616,8 @@ void lib::chassis::velsUntilHeading(double rvolt, double lvolt, double heading,
   }
 }
 
-void lib::chassis::arcTurn(double theta, double radius, double timeout, util::pidConstants cons)
+template <int perSide>
+void lib::chassis<perSide>::arcTurn(double theta, double radius, double timeout, util::pidConstants cons)
 {
   util::timer timer = util::timer(); 
   double curr;
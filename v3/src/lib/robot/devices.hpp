@@ -0,0 +1,37 @@
+#ifndef __DEVICES__
+#define __DEVICES__
+
+/* picks the device implementations at compile time. lib code only uses lib::dev, building with -DLIB_SIM swaps every
+device for the simulated one in sim.hpp
+*/
+#ifdef LIB_SIM
+
+#include "sim.hpp"
+
+namespace lib::dev
+{
+    using motor = lib::sim::motor;
+    using encoder = lib::sim::encoder;
+    using imu = lib::sim::imu;
+    using optical = lib::sim::optical;
+    using vision = lib::sim::vision;
+    using digitalOut = lib::sim::digitalOut;
+}
+
+#else
+
+#include "hw.hpp"
+
+namespace lib::dev
+{
+    using motor = lib::hw::motor;
+    using encoder = lib::hw::encoder;
+    using imu = lib::hw::imu;
+    using optical = lib::hw::optical;
+    using vision = lib::hw::vision;
+    using digitalOut = lib::hw::digitalOut;
+}
+
+#endif
+
+#endif
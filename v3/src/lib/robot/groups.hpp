@@ -2,20 +2,88 @@
 #define __GROUPS__
 
 #include "main.h"
+#include "devices.hpp"
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
 
 namespace lib
 {
+    /* motor group with its ports fixed at compile time, a negative port is reversed like in vexcode:
+        lib::group<3, -10> itsuki;
+    every call expands to one device call per motor with the direction already folded in, so there's no vector to
+    walk, nothing on the heap and no brake mode strings to compare
+
+    the sign is the group's whole direction. a port a pros::Motor declared reversed (glb::saki on 10) has the flag set
+    on the device, which would flip it a second time, so the constructor reads the flags and the group flips those
+    ports back in its own commands. the devices are left alone, so that pros::Motor and anything built from it keep
+    reversing. a pros::Motor declared after the group isnt seen
+    */
+    template <int... ports>
+    class group
+    {
+        static_assert(sizeof...(ports) > 0, "a group needs at least one motor");
+
+        private:
+            // one bit per port whose device flag was set when the group was built
+            uint32_t flagged = 0;
+
+            static constexpr int bit(int port) { return port < 0 ? -port : port; }
+            int flip(int port) const { return (flagged >> bit(port) & 1) ? -1 : 1; }
+
+        public:
+            static constexpr int size = sizeof...(ports);
+            static constexpr std::array<int, size> portList{ports...};
+
+            group(pros::motor_gearset_e_t gearset = pros::E_MOTOR_GEARSET_06)
+            {
+                (dev::motor(ports).setGearing(gearset), ...);
+                ((flagged |= (uint32_t)dev::motor(ports).reversed() << bit(ports)), ...);
+            }
+
+            void spin(double volts)
+            {
+                (dev::motor(ports).move(flip(ports) * volts), ...);
+            }
+
+            void stop(lib::brake mode)
+            {
+                (dev::motor(ports).stop(mode), ...);
+            }
+
+            void setBrake(lib::brake mode)
+            {
+                (dev::motor(ports).setBrake(mode), ...);
+            }
+
+            void reset()
+            {
+                (dev::motor(ports).tare(), ...);
+            }
+
+            double getSpeed()
+            {
+                return (0 + ... + (flip(ports) * dev::motor(ports).velocity())) / size;
+            }
+
+            double getRotation()
+            {
+                return (0 + ... + (flip(ports) * dev::motor(ports).position())) / size;
+            }
+    };
+
     class mtrs
     {
         private:
             pros::motor_brake_mode_e returnBrakeType(char brakeMode);
 
         protected:
-            std::vector<pros::Motor> motors;
+            std::vector<lib::dev::motor> motors;
             int size;
 
         public:
-            mtrs(const std::vector<pros::Motor> & motorsList) : motors(motorsList), size(motorsList.size()){}
+            mtrs(const std::vector<pros::Motor> & motorsList) : motors(motorsList.begin(), motorsList.end()), size(motorsList.size()){}
             
             void spin(double volts);
             void stop(char brakeMode);
@@ -25,17 +93,50 @@ namespace lib
             double getRotation();
     };
 
-    class diffy : public lib::mtrs
+    struct sides
+    {
+        double left;
+        double right;
+    };
+
+    /* drive with perSide motors on each side, the lists say which motors are which side so there's no first half is
+    left assumption to get wrong:
+        lib::diffy<3> drive({frontLeft, midLeft, backLeft}, {frontRight, midRight, backRight});
+    the side getters read both sides in one pass, 4, 6 and 8 motor drives all go through this
+    */
+    template <int perSide>
+    class diffy
     {
+        static_assert(perSide > 0, "a drive needs at least one motor per side");
+
+        private:
+            std::array<lib::dev::motor, perSide> left;
+            std::array<lib::dev::motor, perSide> right;
+
+            template <int... i>
+            static std::array<lib::dev::motor, perSide> side(const pros::Motor (&list)[perSide], std::integer_sequence<int, i...>)
+            {
+                return {lib::dev::motor(list[i])...};
+            }
+
         public:
-            diffy(const std::vector<pros::Motor> & motorsList) : mtrs(motorsList){}
-
-            void spinDiffy(double rvolt, double lvolt);
-            // int size()
-            // {
-            //     return size;
-            // }
-            std::vector<double> getDiffy();
+            static constexpr int size = 2 * perSide;
+
+            // the lists are arrays so a side with the wrong number of motors doesn't compile
+            diffy(const pros::Motor (&leftList)[perSide], const pros::Motor (&rightList)[perSide]) :
+                left(side(leftList, std::make_integer_sequence<int, perSide>{})), right(side(rightList, std::make_integer_sequence<int, perSide>{})){}
+
+            void spin(double volts);
+            void stop(lib::brake mode);
+            void setBrake(lib::brake mode);
+            void reset();
+            double getSpeed();
+            double getRotation();
+
+            // left side first
+            void spinDiffy(double lvolt, double rvolt);
+            lib::sides getPositions();
+            lib::sides getSpeeds();
     };
 
     class pis
@@ -77,8 +178,7 @@ void lib::mtrs::stop(char brakeMode) //NOLINT
 
     for (int i=0; i < size; i++)
     {
-        motors[i].set_brake_mode(brakeType);
-        motors[i].brake();
+        motors[i].stop(brakeType);
     }
 }
 
@@ -88,7 +188,7 @@ void lib::mtrs::setBrake(char brakeMode) //NOLINT
 
     for (int i=0; i < size; i++)
     {
-        motors[i].set_brake_mode(brakeType);
+        motors[i].setBrake(brakeType);
     }
 }
 
@@ -98,7 +198,7 @@ double lib::mtrs::getSpeed() //NOLINT
 
     for (int i=0; i < size; i++)
     {
-        vel += motors[i].get_actual_velocity();
+        vel += motors[i].velocity();
     }
     
     return(vel/size);
@@ -110,7 +210,7 @@ double lib::mtrs::getRotation() //NOLINT
 
     for (int i=0; i < size; i++)
     {
-        rotation += motors[i].get_position();
+        rotation += motors[i].position();
     }
     
     return(rotation/size);
@@ -120,36 +220,101 @@ void lib::mtrs::reset() //NOLINT
 {
     for (int i=0; i < size; i++)
     {
-        motors[i].set_zero_position(0);
+        motors[i].tare();
     }
 }
 
-void lib::diffy::spinDiffy(double rvolt, double lvolt) 
+template <int perSide>
+void lib::diffy<perSide>::spin(double volts) //NOLINT
 {
-    int half = size/2;
+    for (int i=0; i < perSide; i++)
+    {
+        left[i].move(volts);
+        right[i].move(volts);
+    }
+}
 
-    for (int i=0; i < half; i++)
+template <int perSide>
+void lib::diffy<perSide>::stop(lib::brake mode) //NOLINT
+{
+    for (int i=0; i < perSide; i++)
     {
-        motors[i].move(rvolt);
-        motors[i + half].move(lvolt);
+        left[i].stop(mode);
+        right[i].stop(mode);
     }
 }
 
-std::vector<double> lib::diffy::getDiffy() //NOLINT
+template <int perSide>
+void lib::diffy<perSide>::setBrake(lib::brake mode) //NOLINT
 {
-    double dl = 0;
-    double dr = 0;
-    int half = size/2;
-    
-    for (int i=0; i < half; i++)
+    for (int i=0; i < perSide; i++)
     {
-        dl += motors[i].get_position();
-        dr += motors[i + half].get_position();
+        left[i].setBrake(mode);
+        right[i].setBrake(mode);
     }
-    
-    return(std::vector<double> {dr/half, dl/half});
 }
 
+template <int perSide>
+void lib::diffy<perSide>::reset() //NOLINT
+{
+    for (int i=0; i < perSide; i++)
+    {
+        left[i].tare();
+        right[i].tare();
+    }
+}
+
+template <int perSide>
+double lib::diffy<perSide>::getSpeed() //NOLINT
+{
+    lib::sides s = getSpeeds();
+    return((s.left + s.right) / 2);
+}
+
+template <int perSide>
+double lib::diffy<perSide>::getRotation() //NOLINT
+{
+    lib::sides s = getPositions();
+    return((s.left + s.right) / 2);
+}
+
+template <int perSide>
+void lib::diffy<perSide>::spinDiffy(double lvolt, double rvolt) //NOLINT
+{
+    for (int i=0; i < perSide; i++)
+    {
+        left[i].move(lvolt);
+        right[i].move(rvolt);
+    }
+}
+
+template <int perSide>
+lib::sides lib::diffy<perSide>::getPositions() //NOLINT
+{
+    lib::sides s{0, 0};
+
+    for (int i=0; i < perSide; i++)
+    {
+        s.left += left[i].position();
+        s.right += right[i].position();
+    }
+
+    return(lib::sides{s.left / perSide, s.right / perSide});
+}
+
+template <int perSide>
+lib::sides lib::diffy<perSide>::getSpeeds() //NOLINT
+{
+    lib::sides s{0, 0};
+
+    for (int i=0; i < perSide; i++)
+    {
+        s.left += left[i].velocity();
+        s.right += right[i].velocity();
+    }
+
+    return(lib::sides{s.left / perSide, s.right / perSide});
+}
 
 void lib::pis::toggle() 
 {
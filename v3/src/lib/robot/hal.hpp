@@ -0,0 +1,155 @@
+#ifndef __HAL__
+#define __HAL__
+
+#include "main.h"
+#include <cstdint>
+
+/* device interfaces. each device type is a crtp base that holds the shared logic (clamping, heading wrap, brake enum)
+and calls into the implementation it's templated on, so nothing is virtual and the calls inline down to the pros
+calls. lib::hw (hw.hpp) has the brain implementations, lib::sim (sim.hpp) the host ones, devices.hpp picks one as lib::dev
+
+an implementation provides:
+    motor       moveRaw(int) brakeRaw() brakeModeRaw(mode) gearingRaw(gearset) tareRaw() velocityRaw() positionRaw()
+                currentRaw() temperatureRaw() reversedRaw()
+    encoder     ticksRaw() resetRaw()
+    imu         headingRaw()
+    optical     hueRaw() ledRaw(pwm)
+    vision      readRaw(sig, max, objects) -> count
+    digitalOut  writeRaw(bool)
+*/
+namespace lib
+{
+    enum class brake : uint8_t
+    {
+        coast,
+        brake,
+        hold
+    };
+
+    constexpr pros::motor_brake_mode_e_t brakeType(lib::brake mode)
+    {
+        return mode == brake::coast ? pros::E_MOTOR_BRAKE_COAST : mode == brake::brake ? pros::E_MOTOR_BRAKE_BRAKE : pros::E_MOTOR_BRAKE_HOLD;
+    }
+}
+
+namespace lib::hal
+{
+    template <typename impl> class motor
+    {
+        private:
+            impl & self() { return static_cast<impl &>(*this); }
+
+        public:
+            void move(double volts)
+            {
+                self().moveRaw(volts > 127 ? 127 : volts < -127 ? -127 : (int)volts);
+            }
+
+            void stop(lib::brake mode)
+            {
+                stop(brakeType(mode));
+            }
+
+            void stop(pros::motor_brake_mode_e_t mode)
+            {
+                self().brakeModeRaw(mode);
+                self().brakeRaw();
+            }
+
+            void setBrake(lib::brake mode) { self().brakeModeRaw(brakeType(mode)); }
+            void setBrake(pros::motor_brake_mode_e_t mode) { self().brakeModeRaw(mode); }
+            void setGearing(pros::motor_gearset_e_t gearset) { self().gearingRaw(gearset); }
+
+            // the device's own reversed flag, a pros::Motor declared reversed sets it and the device then flips everything
+            bool reversed() { return self().reversedRaw(); }
+
+            void tare() { self().tareRaw(); }
+            double velocity() { return self().velocityRaw(); }
+            double position() { return self().positionRaw(); }
+            double current() { return self().currentRaw(); }
+            double temperature() { return self().temperatureRaw(); }
+    };
+
+    template <typename impl> class encoder
+    {
+        private:
+            impl & self() { return static_cast<impl &>(*this); }
+
+        public:
+            double ticks() { return self().ticksRaw(); }
+            void reset() { self().resetRaw(); }
+
+            // 360 ticks per turn on the red encoders
+            double inches(double wheelCircumference)
+            {
+                return ticks() / 360 * wheelCircumference;
+            }
+    };
+
+    template <typename impl> class imu
+    {
+        private:
+            impl & self() { return static_cast<impl &>(*this); }
+
+        public:
+            // 0-360 with an offset for the starting heading
+            double heading(double offset = 0)
+            {
+                double t = self().headingRaw() + offset;
+                return t <= 360 ? t : t - 360;
+            }
+    };
+
+    template <typename impl> class optical
+    {
+        private:
+            impl & self() { return static_cast<impl &>(*this); }
+
+        public:
+            double hue() { return self().hueRaw(); }
+            void led(int pwm) { self().ledRaw(pwm); }
+
+            // red sits around 10 and blue around 200, the split v2 uses
+            bool red() { return hue() < 60; }
+    };
+
+    template <typename impl> class vision
+    {
+        private:
+            impl & self() { return static_cast<impl &>(*this); }
+
+        public:
+            int read(int sig, int max, pros::vision_object_s_t * objects)
+            {
+                return self().readRaw(sig, max, objects);
+            }
+
+            // biggest object of a signature, false if there isn't one
+            bool largest(int sig, pros::vision_object_s_t & out)
+            {
+                return read(sig, 1, &out) == 1;
+            }
+    };
+
+    template <typename impl> class digitalOut
+    {
+        private:
+            impl & self() { return static_cast<impl &>(*this); }
+
+        public:
+            bool state = false;
+
+            void set(bool value)
+            {
+                state = value;
+                self().writeRaw(value);
+            }
+
+            void toggle()
+            {
+                set(!state);
+            }
+    };
+}
+
+#endif
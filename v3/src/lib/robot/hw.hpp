@@ -0,0 +1,101 @@
+#ifndef __HW__
+#define __HW__
+
+#include "main.h"
+#include "hal.hpp"
+#include <cstdint>
+
+// brain implementations of the hal devices, straight onto the pros calls
+namespace lib::hw
+{
+    /* signed port like lib::group, negative is reversed on top of whatever the device's own reversed flag does. built
+    from a pros::Motor the direction is left to the device, its constructor already set the flag
+    */
+    class motor : public hal::motor<motor>
+    {
+        private:
+            uint8_t port;
+            int8_t direction;
+
+        public:
+            constexpr motor(int p) : port(p < 0 ? -p : p), direction(p < 0 ? -1 : 1) {}
+            motor(const pros::Motor & m) : port(m.get_port()), direction(1) {}
+
+            void moveRaw(int volts) { pros::c::motor_move(port, direction * volts); }
+            void brakeRaw() { pros::c::motor_brake(port); }
+            void brakeModeRaw(pros::motor_brake_mode_e_t mode) { pros::c::motor_set_brake_mode(port, mode); }
+            void gearingRaw(pros::motor_gearset_e_t gearset) { pros::c::motor_set_gearing(port, gearset); }
+            void tareRaw() { pros::c::motor_tare_position(port); }
+            bool reversedRaw() { return pros::c::motor_is_reversed(port) == 1; }
+            double velocityRaw() { return direction * pros::c::motor_get_actual_velocity(port); }
+            double positionRaw() { return direction * pros::c::motor_get_position(port); }
+            double currentRaw() { return pros::c::motor_get_current_draw(port); }
+            double temperatureRaw() { return pros::c::motor_get_temperature(port); }
+    };
+
+    class encoder : public hal::encoder<encoder>
+    {
+        private:
+            pros::ADIEncoder device;
+
+        public:
+            encoder(uint8_t top, uint8_t bottom, bool reversed = false) : device(top, bottom, reversed) {}
+
+            double ticksRaw() { return device.get_value(); }
+            void resetRaw() { device.reset(); }
+    };
+
+    class imu : public hal::imu<imu>
+    {
+        private:
+            pros::Imu device;
+
+        public:
+            imu(uint8_t port) : device(port) {}
+
+            double headingRaw() { return device.get_heading(); }
+    };
+
+    class optical : public hal::optical<optical>
+    {
+        private:
+            pros::Optical device;
+
+        public:
+            optical(uint8_t port) : device(port) {}
+
+            double hueRaw() { return device.get_hue(); }
+            void ledRaw(int pwm) { device.set_led_pwm(pwm); }
+    };
+
+    class vision : public hal::vision<vision>
+    {
+        private:
+            pros::Vision device;
+
+        public:
+            vision(uint8_t port) : device(port) {}
+
+            int readRaw(int sig, int max, pros::vision_object_s_t * objects)
+            {
+                int count = device.read_by_sig(0, sig, max, objects);
+                return count == PROS_ERR ? 0 : count;
+            }
+    };
+
+    class digitalOut : public hal::digitalOut<digitalOut>
+    {
+        private:
+            pros::ADIDigitalOut device;
+
+        public:
+            digitalOut(uint8_t port, bool init = false) : device(port, init)
+            {
+                state = init;
+            }
+
+            void writeRaw(bool value) { device.set_value(value); }
+    };
+}
+
+#endif
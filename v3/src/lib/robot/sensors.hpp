@@ -2,6 +2,7 @@
 #define __SENSORS__
 
 #include "main.h"
+#include "devices.hpp"
 #include "util/util.hpp"
 
 namespace lib 
@@ -9,11 +10,11 @@ namespace lib
     class imu
     {
         private:
-            pros::IMU inertial;
+            lib::dev::imu inertial;
             double initHeading;
         
         public:
-            imu(pros::IMU imu, double heading): inertial(imu), initHeading(heading) {}
+            imu(uint8_t port, double heading): inertial(port), initHeading(heading) {}
 
             double degHeading();
             double radHeading();
@@ -23,14 +24,12 @@ namespace lib
 
 double lib::imu::degHeading() //NOLINT
 {
-    double t = inertial.get_heading() + initHeading;
-    return(t <= 360 ? t : 0 + (t-360));
+    return(inertial.heading(initHeading));
 }
 
 double lib::imu::radHeading() //NOLINT
 {
-    double t = inertial.get_heading() + initHeading;
-    return(t <= 360 ? util::dtr(t) : util::dtr((t-360)));
+    return(util::dtr(inertial.heading(initHeading)));
 }
 
 void lib::imu::init(double heading) //NOLINT
@@ -0,0 +1,224 @@
+#ifndef __SIM__
+#define __SIM__
+
+#include "main.h"
+#include "hal.hpp"
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+/* host implementations of the hal devices for building lib with LIB_SIM (see devices.hpp). the devices read and write
+a shared world that step() moves forward, the host main.h calls it for every millisecond pros::delay() sleeps, so
+loops that delay run at real robot timing. loops that never delay never see time pass on the host
+
+motors are first order: velocity heads toward volts/127 * freeSpeed with timeConstant. a drive() config turns the
+motors on each side into a differential drive that moves the robot, the imu and the tracking encoders follow it
+*/
+namespace lib::sim
+{
+    struct motorState
+    {
+        double volts = 0;
+        double velocity = 0;    // rpm at the motor output
+        double position = 0;    // degrees
+        pros::motor_brake_mode_e_t brake = pros::E_MOTOR_BRAKE_COAST;
+        bool braking = false;
+    };
+
+    struct driveConfig
+    {
+        std::vector<int> left;     // signed ports, negative if forward on the motor is backward for the robot
+        std::vector<int> right;
+        double trackWidth = 12;    // inches
+        double wheelDiameter = 3.25;
+        double ratio = 0.6;        // wheel turns per motor turn
+    };
+
+    struct world
+    {
+        motorState motors[22];
+        driveConfig drive;
+        bool hasDrive = false;
+
+        double x = 0, y = 0;        // inches
+        double heading = 0;         // degrees clockwise, like the imu
+        double forwardTravel = 0;   // inches, for a tracking wheel
+        double sideTravel = 0;
+
+        double hue = 200;
+        std::vector<pros::vision_object_s_t> objects;
+        bool outputs[9] = {};
+        uint8_t sidewaysEncoder = 0;    // top port of the encoder on the horizontal tracking wheel
+
+        double freeSpeed = 600;
+        double timeConstant = 0.08;  // seconds, loaded on the ground
+    };
+
+    world & state()
+    {
+        static world w;
+        return w;
+    }
+
+    void drive(driveConfig config)
+    {
+        state().drive = config;
+        state().hasDrive = true;
+    }
+
+    double sideSpeed(const std::vector<int> & ports)
+    {
+        double sum = 0;
+
+        for (int p : ports)
+        {
+            sum += (p < 0 ? -1 : 1) * state().motors[p < 0 ? -p : p].velocity;
+        }
+
+        return ports.empty() ? 0 : sum / ports.size();
+    }
+
+    void step(double dt)
+    {
+        world & w = state();
+
+        for (int i = 1; i < 22; i++)
+        {
+            motorState & m = w.motors[i];
+            double target = m.braking ? 0 : m.volts / 127 * w.freeSpeed;
+            double tau = m.braking && m.brake != pros::E_MOTOR_BRAKE_COAST ? w.timeConstant / 4 : w.timeConstant;
+
+            m.velocity += (target - m.velocity) * dt / tau;
+            m.position += m.velocity / 60 * 360 * dt;
+        }
+
+        if (w.hasDrive)
+        {
+            // rpm at the motor to inches per second at the wheel
+            double scale = w.drive.ratio * w.drive.wheelDiameter * M_PI / 60;
+            double left = sideSpeed(w.drive.left) * scale;
+            double right = sideSpeed(w.drive.right) * scale;
+            double forward = (left + right) / 2;
+            double rad = w.heading * M_PI / 180;
+
+            w.heading += (left - right) / w.drive.trackWidth * 180 / M_PI * dt;
+            w.heading = std::fmod(std::fmod(w.heading, 360) + 360, 360);
+            w.x += forward * std::sin(rad) * dt;
+            w.y += forward * std::cos(rad) * dt;
+            w.forwardTravel += forward * dt;
+        }
+    }
+
+    // hooked into the host delay() once per simulated millisecond
+    struct stepper
+    {
+        stepper()
+        {
+            pros::host::onTick() = [] { step(0.001); };
+        }
+    };
+
+    stepper autoStep;
+
+    // - devices
+    class motor : public hal::motor<motor>
+    {
+        private:
+            uint8_t port;
+            int8_t direction;
+
+            motorState & m() { return state().motors[port]; }
+
+            // the device's reversed flag, kept by the host pros shim, flips everything like it does on the brain
+            int sign() { return reversedRaw() ? -direction : direction; }
+
+        public:
+            constexpr motor(int p) : port(p < 0 ? -p : p), direction(p < 0 ? -1 : 1) {}
+            motor(const pros::Motor & device) : port(device.get_port()), direction(1) {}
+
+            void moveRaw(int volts) { m().volts = sign() * volts; m().braking = false; }
+            void brakeRaw() { m().volts = 0; m().braking = true; }
+            void brakeModeRaw(pros::motor_brake_mode_e_t mode) { m().brake = mode; }
+            void gearingRaw(pros::motor_gearset_e_t gearset) {}
+            void tareRaw() { m().position = 0; }
+            bool reversedRaw() { return pros::c::motor_is_reversed(port) == 1; }
+            double velocityRaw() { return sign() * m().velocity; }
+            double positionRaw() { return sign() * m().position; }
+            double currentRaw() { return std::fabs(m().volts / 127 * (1 - std::fabs(m().velocity) / state().freeSpeed)) * 2500; }
+            double temperatureRaw() { return 25; }
+    };
+
+    // a tracking wheel, follows the robot forward unless its top port is the world's sidewaysEncoder
+    class encoder : public hal::encoder<encoder>
+    {
+        private:
+            bool forward;
+            double zero = 0;
+            double wheelCircumference;
+
+            double travel() { return forward ? state().forwardTravel : state().sideTravel; }
+
+        public:
+            encoder(uint8_t top, uint8_t bottom, bool reversed = false, double circumference = 2.75 * M_PI) :
+                forward(top != state().sidewaysEncoder), wheelCircumference(circumference) {}
+
+            double ticksRaw() { return (travel() - zero) / wheelCircumference * 360; }
+            void resetRaw() { zero = travel(); }
+    };
+
+    class imu : public hal::imu<imu>
+    {
+        public:
+            imu(uint8_t port) {}
+
+            double headingRaw() { return state().heading; }
+    };
+
+    class optical : public hal::optical<optical>
+    {
+        public:
+            optical(uint8_t port) {}
+
+            double hueRaw() { return state().hue; }
+            void ledRaw(int pwm) {}
+    };
+
+    class vision : public hal::vision<vision>
+    {
+        public:
+            vision(uint8_t port) {}
+
+            int readRaw(int sig, int max, pros::vision_object_s_t * objects)
+            {
+                int count = 0;
+
+                for (const pros::vision_object_s_t & o : state().objects)
+                {
+                    if (o.signature == sig && count < max)
+                    {
+                        objects[count++] = o;
+                    }
+                }
+
+                return count;
+            }
+    };
+
+    class digitalOut : public hal::digitalOut<digitalOut>
+    {
+        private:
+            uint8_t port;
+
+        public:
+            // adi ports can be given as 1-8 or 'A'-'H'
+            digitalOut(uint8_t p, bool init = false) : port(p >= 'A' ? p - 'A' + 1 : p)
+            {
+                state = init;
+                writeRaw(init);
+            }
+
+            void writeRaw(bool value) { sim::state().outputs[port] = value; }
+    };
+}
+
+#endif
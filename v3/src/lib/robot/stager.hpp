@@ -1,30 +1,114 @@
+#ifndef __STAGER__
+#define __STAGER__
+
+#include "main.h"
 #include "util/util.hpp"
-#include <unordered_map>
+#include <algorithm>
+#include <vector>
 
 namespace lib
 {
+    /* time triggered actions for the time based autons. the actions are sorted once by start and by end, and two
+    cursors walk those lists as the time goes past, so a tick only looks at actions starting or ending and the ones
+    running. between events with nothing to update it sleeps until the next one. run() returns when every action
+    has ended
+    */
     class stager
     {
         private:
-          std::vector<util::action> actions;
+            std::vector<util::action> actions;
+            std::vector<int> byStart;
+            std::vector<int> byEnd;
+            std::vector<int> active;    // started and not ended, with a func to update
+
+            int startOf(int i) { return actions[i].range.getStart(); }
+            int endOf(int i) { return actions[i].range.getEnd(); }
 
         public:
-            stager(std::vector<util::action> a) : actions(a) {}
+            stager(std::vector<util::action> a);
+
+            void run(util::timer timer, int period = 10);
+    };
+}
+
+lib::stager::stager(std::vector<util::action> a) : actions(a) //NOLINT
+{
+    for (int i = 0; i < actions.size(); i++)
+    {
+        // an end before the start is never in range
+        if (endOf(i) >= startOf(i))
+        {
+            byStart.push_back(i);
+            byEnd.push_back(i);
+        }
+    }
 
-            void run(util::timer timer)
+    std::stable_sort(byStart.begin(), byStart.end(), [this](int a, int b) { return startOf(a) < startOf(b); });
+    std::stable_sort(byEnd.begin(), byEnd.end(), [this](int a, int b) { return endOf(a) < endOf(b); });
+}
+
+void lib::stager::run(util::timer timer, int period) //NOLINT
+{
+    int nextStart = 0;
+    int nextEnd = 0;
+    int count = byStart.size();
+    active.clear();
+
+    while (nextEnd < count)
+    {
+        int time = timer.time();
+
+        // - starting
+        for (; nextStart < count && startOf(byStart[nextStart]) <= time; nextStart++)
+        {
+            util::action & a = actions[byStart[nextStart]];
+
+            if (a.enter != nullptr)
             {
-                while (true)
-                {
-                    int time = timer.time();
-                    for (util::action i : actions)
-                    {
-                        if(i.range.inRange(time))
-                        {
-                            i.func(i.args);
-                        }
-                    }
-                }
+                a.enter(a.args);
             }
-    };
-    
-}
\ No newline at end of file
+
+            if (a.func != nullptr)
+            {
+                active.push_back(byStart[nextStart]);
+            }
+        }
+
+        // - ending, ranges include their end
+        for (; nextEnd < count && endOf(byEnd[nextEnd]) < time; nextEnd++)
+        {
+            int index = byEnd[nextEnd];
+            util::action & a = actions[index];
+            std::vector<int>::iterator found = std::find(active.begin(), active.end(), index);
+
+            if (found != active.end())
+            {
+                *found = active.back();
+                active.pop_back();
+            }
+
+            if (a.exit != nullptr)
+            {
+                a.exit(a.args);
+            }
+        }
+
+        // - running
+        for (int i : active)
+        {
+            actions[i].func(actions[i].args);
+        }
+
+        // - sleep until something starts or ends, or the next update
+        int wake = nextEnd < count ? endOf(byEnd[nextEnd]) + 1 : time;
+        wake = nextStart < count ? std::min(wake, startOf(byStart[nextStart])) : wake;
+        wake = active.empty() ? wake : std::min(wake, time + period);
+
+        if (nextEnd < count)
+        {
+            pros::delay(std::max(wake - timer.time(), 1));
+        }
+    }
+}
+
+#endif
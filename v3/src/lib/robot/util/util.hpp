@@ -70,7 +70,7 @@ class util::coordinate
             y = py;
         }
 
-        coordinate();
+        coordinate() : x(0), y(0) {}
 };
 
 class util::pose
@@ -288,6 +288,11 @@ class util::timeRange
         {
             return (start);
         }
+
+        int getEnd()
+        {
+            return (end);
+        }
 };
 
 struct util::args
@@ -297,11 +302,16 @@ struct util::args
     util::pid pid;
 };
 
+/* func runs every tick while the time is in range, enter and exit once on the way in and out (see lib::stager).
+they get the action's own args, so a pid in them keeps its integral and last error from one tick to the next
+*/
 struct util::action 
 {
-    void(*func)(util::args);
+    void(*func)(util::args &);
     util::timeRange range;
     util::args args;
+    void(*enter)(util::args &) = nullptr;
+    void(*exit)(util::args &) = nullptr;
 }; 
 
 double util::dtr(double input) //NOLINT
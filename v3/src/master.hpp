@@ -49,7 +49,7 @@ void normal()
 
         else
         {
-            robot::itsuki.stop('c');
+            robot::itsuki.stop(lib::brake::coast);
         }
 
         if(R2)
@@ -0,0 +1,81 @@
+/* runs lib::chassis against the simulated devices, same source as the brain build with the devices swapped.
+
+    g++ -std=c++17 -DLIB_SIM -I tools/host -I src tools/chassissim.cpp -o chassissim && ./chassissim
+
+prints the simulated heading and position every 100ms of each motion. only motions that delay can run on the host,
+the ones that spin without delaying never see simulated time move
+*/
+
+#include "main.h"
+#include "lib/lib.hpp"
+
+void log(const char * name)
+{
+    lib::sim::world & w = lib::sim::state();
+    printf("%-9s %6.2fs  heading %7.2f  x %6.2f  y %6.2f\n", name, pros::millis() / 1000.0, w.heading, w.x, w.y);
+}
+
+// the sim uses signed ports for which way is forward for the robot, so reversed motors are negative
+std::vector<int> signedPorts(const pros::Motor * motors, int count)
+{
+    std::vector<int> ports;
+
+    for (int i = 0; i < count; i++)
+    {
+        ports.push_back(motors[i].is_reversed() ? -motors[i].get_port() : motors[i].get_port());
+    }
+
+    return ports;
+}
+
+// same motions on a drive with perSide motors a side, starting from the origin
+template <int perSide>
+void run(const pros::Motor (&left)[perSide], const pros::Motor (&right)[perSide])
+{
+    lib::sim::state() = lib::sim::world();
+    lib::sim::drive(lib::sim::driveConfig{signedPorts(left, perSide), signedPorts(right, perSide), 11.5, 3.25, 0.6});
+
+    lib::diffy<perSide> motors(left, right);
+    lib::imu imu(5, 0);
+    util::coordinate pos(0, 0);
+    lib::chassis<perSide> chass(motors, imu, pos, 0.5, 0.5);
+
+    printf("- %d motor drive\n", 2 * perSide);
+
+    // sample the world every 100ms while the motions run
+    std::function<void()> step = pros::host::onTick();
+    const char * motion = "";
+    pros::host::onTick() = [&] {
+        step();
+
+        if (pros::millis() % 100 == 0)
+        {
+            log(motion);
+        }
+    };
+
+    motion = "aspin 90";
+    chass.aspin(90, 1500, util::pidConstants(3.7, 1.3, 26, 0.05, 2.4, 20));
+
+    motion = "autoDrive";
+    chass.autoDrive(1000, 90, 1500);
+
+    pros::host::onTick() = step;
+    log("done");
+}
+
+int main()
+{
+    using pros::Motor;
+    const pros::motor_gearset_e_t blue = pros::E_MOTOR_GEARSET_06;
+
+    // v2
+    run<2>({Motor(3, blue, true), Motor(4, blue, true)}, {Motor(2, blue, false), Motor(1, blue, false)});
+
+    // v3, reversal matches v3/src/global.hpp
+    run<3>({Motor(8, blue, true), Motor(9, blue, false), Motor(7, blue, true)},
+           {Motor(2, blue, false), Motor(4, blue, true), Motor(1, blue, false)});
+
+    run<4>({Motor(8, blue, true), Motor(9, blue, false), Motor(7, blue, true), Motor(6, blue, false)},
+           {Motor(2, blue, false), Motor(4, blue, true), Motor(1, blue, false), Motor(5, blue, true)});
+}
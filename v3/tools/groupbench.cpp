@@ -0,0 +1,125 @@
+/* times the v2 vector/string motor group, the v3 vector/char one and lib::group on the same four motors.
+
+    g++ -std=c++17 -O2 -I tools/host -I src tools/groupbench.cpp -o groupbench && ./groupbench
+
+device calls are stubbed out of line (tools/host/main.h), so the numbers are the group's own overhead on top of the
+calls it makes. first it checks that every group, and lib::diffy, puts the same signed voltage on each port
+*/
+
+#include "main.h"
+#include "lib/robot/groups.hpp"
+#include <chrono>
+#include <string>
+#include <vector>
+
+// - v2 group::mtrs, copied since v2/src/global.hpp needs the real devices
+namespace v2
+{
+    class mtrs
+    {
+        private:
+            pros::motor_brake_mode_e returnBrakeType(std::string brakeMode)
+            {
+                return brakeMode == "c" ? pros::E_MOTOR_BRAKE_COAST : brakeMode == "b" ? pros::E_MOTOR_BRAKE_BRAKE : pros::E_MOTOR_BRAKE_HOLD;
+            }
+
+        protected:
+            std::vector<pros::Motor> motors;
+            std::string name;
+            int size;
+
+        public:
+            mtrs(const std::vector<pros::Motor> & motorsList, std::string title) : motors(motorsList) , name(title), size(motorsList.size()){}
+
+            void spin(double volts = 127)
+            {
+                for (int i=0; i < size; i++)
+                {
+                    motors[i].move(volts);
+                }
+            }
+
+            void stop(std::string brakeMode)
+            {
+                pros::motor_brake_mode_e brakeType = returnBrakeType(brakeMode);
+
+                for (int i=0; i < size; i++)
+                {
+                    motors[i].set_brake_mode(brakeType);
+                    motors[i].brake();
+                }
+            }
+
+            double getSpeed()
+            {
+                double vel = 0;
+
+                for (int i=0; i < size; i++)
+                {
+                    vel += motors[i].get_actual_velocity();
+                }
+
+                return(vel/size);
+            }
+    };
+}
+
+const int iterations = 2000000;
+volatile double sink;
+
+template <typename F> double time(F f)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < iterations; i++)
+    {
+        f(i);
+    }
+
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+}
+
+int main()
+{
+    pros::Motor a(3, pros::E_MOTOR_GEARSET_06, false);
+    pros::Motor b(10, pros::E_MOTOR_GEARSET_06, true);
+    pros::Motor c(4, pros::E_MOTOR_GEARSET_06, false);
+    pros::Motor d(7, pros::E_MOTOR_GEARSET_06, true);
+
+    v2::mtrs old(std::vector<pros::Motor>{a, b, c, d}, "bench");
+    lib::mtrs refactor(std::vector<pros::Motor>{a, b, c, d});
+    lib::diffy<2> drive({a, c}, {b, d});
+
+    // the group is built over the same reversed ports, and must leave their flags alone for the others
+    lib::group<3, -10, 4, -7> fixed;
+
+    // same commands have to reach the same ports, reversed once
+    old.spin(50);
+    int32_t v2Volts = pros::host::ports()[10].voltage;
+    refactor.spin(50);
+    int32_t mtrsVolts = pros::host::ports()[10].voltage;
+    fixed.spin(50);
+    printf("port 10 at 50: group %d, lib::mtrs %d, v2 %d\n", pros::host::ports()[10].voltage, mtrsVolts, v2Volts);
+
+    // the drive built from the same motors, each side gets its own command and a reversed motor flips it once
+    drive.spinDiffy(50, -50);
+    printf("diffy at 50, -50: ports 3 %d, 4 %d, 10 %d, 7 %d\n\n", pros::host::ports()[3].voltage, pros::host::ports()[4].voltage,
+        pros::host::ports()[10].voltage, pros::host::ports()[7].voltage);
+
+    printf("%-10s %10s %10s %10s  (ns per call, 4 motors)\n", "", "spin", "stop", "getSpeed");
+
+    printf("%-10s %10.1f %10.1f %10.1f\n", "v2",
+        time([&](int i) { old.spin(i & 127); }),
+        time([&](int i) { old.stop("b"); }),
+        time([&](int i) { sink = old.getSpeed(); }));
+
+    printf("%-10s %10.1f %10.1f %10.1f\n", "lib::mtrs",
+        time([&](int i) { refactor.spin(i & 127); }),
+        time([&](int i) { refactor.stop('b'); }),
+        time([&](int i) { sink = refactor.getSpeed(); }));
+
+    printf("%-10s %10.1f %10.1f %10.1f\n", "lib::group",
+        time([&](int i) { fixed.spin(i & 127); }),
+        time([&](int i) { fixed.stop(lib::brake::brake); }),
+        time([&](int i) { sink = fixed.getSpeed(); }));
+}
@@ -0,0 +1,173 @@
+#ifndef __HOST_MAIN__
+#define __HOST_MAIN__
+
+/* stands in for the pros main.h so lib headers can be built on a computer for the tools in this folder. the motor
+calls just store what they're told in a per port table, every call is kept out of line like the real pros calls are.
+like on the brain, reversed is a flag on the port that the c calls apply, so every pros::Motor on a port shares it.
+the other devices are only declared, build with -DLIB_SIM to get working ones from lib/robot/sim.hpp
+
+time is simulated, delay() moves the clock forward a millisecond at a time and calls onTick() for each one
+*/
+
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+#define HOST_CALL __attribute__((noinline))
+#define PROS_ERR (INT32_MAX)
+
+namespace pros
+{
+    enum motor_gearset_e_t { E_MOTOR_GEARSET_36, E_MOTOR_GEARSET_18, E_MOTOR_GEARSET_06 };
+    enum motor_brake_mode_e_t { E_MOTOR_BRAKE_COAST, E_MOTOR_BRAKE_BRAKE, E_MOTOR_BRAKE_HOLD };
+    typedef motor_brake_mode_e_t motor_brake_mode_e;
+
+    struct vision_object_s_t
+    {
+        uint16_t signature;
+        int type;
+        int16_t left_coord;
+        int16_t top_coord;
+        int16_t width;
+        int16_t height;
+        uint16_t angle;
+        int16_t x_middle_coord;
+        int16_t y_middle_coord;
+    };
+
+    namespace host
+    {
+        inline uint64_t & clock()
+        {
+            static uint64_t micros = 0;
+            return micros;
+        }
+
+        inline std::function<void()> & onTick()
+        {
+            static std::function<void()> tick;
+            return tick;
+        }
+
+        struct port
+        {
+            volatile int32_t voltage;
+            volatile int brake;
+            volatile double position;
+            volatile double velocity;
+            volatile int gearset;
+            volatile bool reversed;
+        };
+
+        inline port * ports()
+        {
+            static port table[22];
+            return table;
+        }
+    }
+
+    namespace c
+    {
+        HOST_CALL inline int32_t motor_move(uint8_t p, int32_t voltage) { host::ports()[p].voltage = host::ports()[p].reversed ? -voltage : voltage; return 1; }
+        HOST_CALL inline int32_t motor_brake(uint8_t p) { host::ports()[p].voltage = 0; return 1; }
+        HOST_CALL inline int32_t motor_set_brake_mode(uint8_t p, motor_brake_mode_e_t mode) { host::ports()[p].brake = mode; return 1; }
+        HOST_CALL inline int32_t motor_set_gearing(uint8_t p, motor_gearset_e_t gearset) { host::ports()[p].gearset = gearset; return 1; }
+        HOST_CALL inline int32_t motor_set_reversed(uint8_t p, bool reverse) { host::ports()[p].reversed = reverse; return 1; }
+        HOST_CALL inline int32_t motor_tare_position(uint8_t p) { host::ports()[p].position = 0; return 1; }
+        HOST_CALL inline int32_t motor_set_zero_position(uint8_t p, double position) { host::ports()[p].position -= position; return 1; }
+        HOST_CALL inline int32_t motor_is_reversed(uint8_t p) { return host::ports()[p].reversed; }
+        HOST_CALL inline double motor_get_actual_velocity(uint8_t p) { return (host::ports()[p].reversed ? -1 : 1) * host::ports()[p].velocity; }
+        HOST_CALL inline double motor_get_position(uint8_t p) { return (host::ports()[p].reversed ? -1 : 1) * host::ports()[p].position; }
+        HOST_CALL inline int32_t motor_get_current_draw(uint8_t p) { return 0; }
+        HOST_CALL inline double motor_get_temperature(uint8_t p) { return 25; }
+    }
+
+    inline uint32_t millis()
+    {
+        return host::clock() / 1000;
+    }
+
+    inline uint64_t micros()
+    {
+        return host::clock();
+    }
+
+    inline void delay(uint32_t ms)
+    {
+        for (uint32_t i = 0; i < ms; i++)
+        {
+            host::clock() += 1000;
+
+            if (host::onTick())
+            {
+                host::onTick()();
+            }
+        }
+    }
+
+    class Motor
+    {
+        private:
+            uint8_t port;
+
+        public:
+            Motor(int8_t p, motor_gearset_e_t gearset = E_MOTOR_GEARSET_18, bool reverse = false) : port(p)
+            {
+                c::motor_set_gearing(port, gearset);
+                c::motor_set_reversed(port, reverse);
+            }
+
+            uint8_t get_port() const { return port; }
+            int32_t is_reversed() const { return c::motor_is_reversed(port); }
+
+            HOST_CALL int32_t move(int32_t voltage) const { return c::motor_move(port, voltage); }
+            HOST_CALL int32_t brake() const { return c::motor_brake(port); }
+            HOST_CALL int32_t set_brake_mode(motor_brake_mode_e_t mode) const { return c::motor_set_brake_mode(port, mode); }
+            HOST_CALL int32_t set_zero_position(double position) const { return c::motor_set_zero_position(port, position); }
+            HOST_CALL double get_actual_velocity() const { return c::motor_get_actual_velocity(port); }
+            HOST_CALL double get_position() const { return c::motor_get_position(port); }
+    };
+
+    class ADIDigitalOut
+    {
+        public:
+            ADIDigitalOut(uint8_t port, bool init = false) {}
+            int32_t set_value(bool value) const { return 1; }
+    };
+
+    class ADIEncoder
+    {
+        public:
+            ADIEncoder(uint8_t top, uint8_t bottom, bool reversed);
+            int32_t get_value() const;
+            int32_t reset() const;
+    };
+
+    class Imu
+    {
+        public:
+            Imu(uint8_t port);
+            double get_heading() const;
+    };
+
+    class Optical
+    {
+        public:
+            Optical(uint8_t port);
+            double get_hue();
+            int32_t set_led_pwm(uint8_t value);
+    };
+
+    class Vision
+    {
+        public:
+            Vision(uint8_t port);
+            int32_t read_by_sig(uint32_t index, uint32_t sig, uint32_t count, vision_object_s_t * objects) const;
+    };
+}
+
+#endif
@@ -0,0 +1,6 @@
+#ifndef __HOST_MISC__
+#define __HOST_MISC__
+
+// pros/misc.h is included by util.hpp, nothing in it is needed on the host
+
+#endif